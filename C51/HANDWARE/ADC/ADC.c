@@ -33,15 +33,52 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "ADC.h" // OK
+#include "TimeStamp.h"
+#if ADC_SAMPLER_ENABLE
+#include "SoftTimer.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
 #define ADC_START_ADDR		0x32 ///< Starting address for ADC data in DGUS registers.
 
+#if ADC_SAMPLER_ENABLE
+#if ADC_RING_LOG2 > 7
+#error "ADC_RING_LOG2 above 7 overflows the uint8_t ring index"
+#endif
+
+#define ADC_RING_DEPTH		(1 << ADC_RING_LOG2)	///< Decimated samples per channel.
+#define ADC_DECIM_LOG2_MAX	7						///< Largest AdcSamplerStart() DecimLog2.
+
+/**
+ * @brief Background sampling state of one channel.
+ */
+typedef struct
+{
+    uint16_t Period;                    ///< Sampling period in ms, 0 when stopped.
+    uint16_t Countdown;                 ///< ms left to the next reading.
+    uint8_t DecimLog2;                  ///< Raw readings per ring entry, log2.
+    uint8_t DecimCnt;                   ///< Raw readings in Acc.
+    uint32_t Acc;                       ///< Sum of the pending raw readings.
+    uint16_t Last;                      ///< Last raw reading.
+    uint16_t Min;                       ///< Minimum raw reading.
+    uint16_t Max;                       ///< Maximum raw reading.
+    uint16_t Ring[ADC_RING_DEPTH];      ///< Decimated samples.
+    uint8_t Head;                       ///< Next ring slot to write.
+    uint8_t Count;                      ///< Valid ring entries.
+    uint32_t Sum;                       ///< Sum of all ring entries.
+    Filter Flt;                         ///< Filter run on the raw readings.
+} AdcSampler;
+#endif
+
 //==============================================================================
 //---------------------------------VARIABLES------------------------------------
 //==============================================================================
+#if ADC_SAMPLER_ENABLE
+static xdata AdcSampler AdcCh[ADC_CHANNELS];				///< Sampler state, index Channel - 1.
+static xdata uint8_t AdcTimer = SOFT_TIMER_NONE;		///< 1 ms sampler tick, running while any channel is.
+#endif
 
 //==============================================================================
 //---------------------------------ADC READ-------------------------------------
@@ -62,6 +99,37 @@ uint16_t AdcRead(AdcChannel Channel)
     return ReturnValue;
 }
 
+//==============================================================================
+//-------------------------------ADC READ ALL-----------------------------------
+//==============================================================================
+/**
+ * @brief Reads all channels in one DGUS burst.
+ * @param Snap Receives the values and the timestamp.
+ */
+void AdcReadAll(AdcSnapshot *Snap)
+{
+    Snap->Ticks = TimeNowTicks();
+    ReadDgusVp(ADC_START_ADDR + ADC_CHANNEL_1, (uint8_t*)Snap->Value, ADC_CHANNELS);
+}
+
+#if ADC_BENCH_ENABLE
+/**
+ * @brief Measures the per-channel and the burst read paths on the target.
+ */
+void AdcBench(void)
+{
+    AdcSnapshot Snap;
+    uint16_t result[3];
+    uint8_t run;
+    uint8_t ch;
+
+    BENCH_TIME(result[0], run,
+        for (ch = ADC_CHANNEL_1; ch <= ADC_CHANNEL_7; ch++) Snap.Value[ch - 1] = AdcRead((AdcChannel)ch));
+    BENCH_TIME(result[1], run, AdcReadAll(&Snap));
+    BenchReport(ADC_BENCH_VP, result, 2);
+}
+#endif
+
 //==============================================================================
 //-----------------------------ADC READ AVERAGE---------------------------------
 //==============================================================================
@@ -92,6 +160,246 @@ uint16_t AdcReadAvg(AdcChannel Channel, uint16_t AvgCnt)
 //==============================================================================
 //-------------------------------ADC PROCESS------------------------------------
 //==============================================================================
+#if ADC_SAMPLER_ENABLE
+/**
+ * @brief Clears the results of a sampler channel.
+ * @param p Channel state.
+ */
+static void AdcSamplerClear(AdcSampler *p)
+{
+    uint8_t i;
+
+    p->DecimCnt = 0;
+    p->Acc = 0;
+    p->Last = 0;
+    p->Min = 0xFFFF;
+    p->Max = 0;
+    for (i = 0; i < ADC_RING_DEPTH; i++) p->Ring[i] = 0;
+    p->Head = 0;
+    p->Count = 0;
+    p->Sum = 0;
+    FilterReset(&p->Flt);
+}
+
+/**
+ * @brief Feeds one reading into last, min/max and the decimated ring.
+ * @param p Channel state.
+ * @param Value Raw AD_VALUE.
+ */
+static void AdcSamplerTake(AdcSampler *p, uint16_t Value)
+{
+    uint8_t i;
+
+    p->Last = Value;
+    if (Value < p->Min) p->Min = Value;
+    if (Value > p->Max) p->Max = Value;
+    FilterUpdate(&p->Flt, Value);
+
+    p->Acc += Value;
+    if (++p->DecimCnt < (uint8_t)(1 << p->DecimLog2)) return;
+
+    Value = (uint16_t)(p->Acc >> p->DecimLog2);
+    p->Acc = 0;
+    p->DecimCnt = 0;
+
+    if (p->Count == 0)
+    {
+        //First entry fills the whole ring, so the average is a plain shift
+        for (i = 0; i < ADC_RING_DEPTH; i++) p->Ring[i] = Value;
+        p->Sum = (uint32_t)Value << ADC_RING_LOG2;
+    }
+    else
+    {
+        p->Sum -= p->Ring[p->Head];
+        p->Ring[p->Head] = Value;
+        p->Sum += Value;
+    }
+    p->Head = (p->Head + 1) & (ADC_RING_DEPTH - 1);
+    if (p->Count < ADC_RING_DEPTH) p->Count++;
+}
+
+/**
+ * @brief 1 ms sampler tick (SoftTimer callback, main loop context).
+ */
+static void AdcSamplerTick(void)
+{
+    AdcSnapshot Snap;
+    uint8_t Due = 0;
+    uint8_t Last = 0;
+    uint8_t Cnt = 0;
+    uint8_t i;
+    AdcSampler *p = AdcCh;
+
+    for (i = 0; i < ADC_CHANNELS; i++, p++)
+    {
+        if (p->Period == 0) continue;
+        if (--p->Countdown) continue;
+        p->Countdown = p->Period;
+        Due |= 1 << i;
+        Last = i;
+        Cnt++;
+    }
+
+    if (Cnt == 0) return;
+    if (Cnt == 1)
+    {
+        AdcSamplerTake(&AdcCh[Last], AdcRead((AdcChannel)(Last + 1)));
+        return;
+    }
+
+    AdcReadAll(&Snap);		//Two or more channels due: one burst is cheaper
+    for (i = 0; i < ADC_CHANNELS; i++)
+    {
+        if (Due & (1 << i)) AdcSamplerTake(&AdcCh[i], Snap.Value[i]);
+    }
+}
+
+/**
+ * @brief Clears all channels of the background sampler.
+ */
+void AdcSamplerInit(void)
+{
+    uint8_t i;
+
+    if (AdcTimer != SOFT_TIMER_NONE) SoftTimerStop(AdcTimer);
+    AdcTimer = SOFT_TIMER_NONE;
+    for (i = 0; i < ADC_CHANNELS; i++)
+    {
+        AdcCh[i].Period = 0;
+        FilterInit(&AdcCh[i].Flt, FILTER_NONE, 0);
+        AdcSamplerClear(&AdcCh[i]);
+    }
+}
+
+/**
+ * @brief Starts background sampling of a channel.
+ * @param Channel The ADC channel to sample (1 to 7).
+ * @param PeriodMs Sampling period in ms (0 is treated as 1).
+ * @param DecimLog2 Raw readings per ring entry, 1 << DecimLog2 (0 to 7, larger is treated as 7).
+ */
+void AdcSamplerStart(AdcChannel Channel, uint16_t PeriodMs, uint8_t DecimLog2)
+{
+    AdcSampler *p;
+
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return;
+    p = &AdcCh[Channel - 1];
+
+    AdcSamplerClear(p);
+    p->DecimLog2 = DecimLog2 > ADC_DECIM_LOG2_MAX ? ADC_DECIM_LOG2_MAX : DecimLog2;
+    p->Period = PeriodMs ? PeriodMs : 1;
+    p->Countdown = 1;				//First reading on the next tick
+
+    if (AdcTimer == SOFT_TIMER_NONE) AdcTimer = SoftTimerStart(AdcSamplerTick, 1, 1);
+}
+
+/**
+ * @brief Stops background sampling of a channel; its results stay readable.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void AdcSamplerStop(AdcChannel Channel)
+{
+    uint8_t i;
+
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return;
+    AdcCh[Channel - 1].Period = 0;
+
+    for (i = 0; i < ADC_CHANNELS; i++)
+    {
+        if (AdcCh[i].Period) return;
+    }
+    if (AdcTimer != SOFT_TIMER_NONE) SoftTimerStop(AdcTimer);
+    AdcTimer = SOFT_TIMER_NONE;
+}
+
+/**
+ * @brief Returns the last raw reading of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Last AD_VALUE, 0 before the first reading.
+ */
+uint16_t AdcGetLast(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    return AdcCh[Channel - 1].Last;
+}
+
+/**
+ * @brief Returns the running average of the ring.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Average, 0 before the first ring entry.
+ */
+uint16_t AdcGetAvg(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    return (uint16_t)(AdcCh[Channel - 1].Sum >> ADC_RING_LOG2);
+}
+
+/**
+ * @brief Returns the smallest raw reading since start or AdcResetMinMax().
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Minimum, 0xFFFF before the first reading.
+ */
+uint16_t AdcGetMin(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0xFFFF;
+    return AdcCh[Channel - 1].Min;
+}
+
+/**
+ * @brief Returns the largest raw reading since start or AdcResetMinMax().
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Maximum, 0 before the first reading.
+ */
+uint16_t AdcGetMax(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    return AdcCh[Channel - 1].Max;
+}
+
+/**
+ * @brief Restarts min/max tracking of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void AdcResetMinMax(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return;
+    AdcCh[Channel - 1].Min = 0xFFFF;
+    AdcCh[Channel - 1].Max = 0;
+}
+
+/**
+ * @brief Selects the filter run on every raw reading of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ * @param Type Filter type.
+ * @param Param Type parameter, see FilterType.
+ */
+void AdcSamplerFilter(AdcChannel Channel, FilterType Type, uint8_t Param)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return;
+    FilterInit(&AdcCh[Channel - 1].Flt, Type, Param);
+}
+
+/**
+ * @brief Returns the filter output of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Filtered value, 0 before the first reading.
+ */
+uint16_t AdcGetFiltered(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    return FilterOut(&AdcCh[Channel - 1].Flt);
+}
+
+/**
+ * @brief Returns the number of valid ring entries.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint8_t Entries averaged by AdcGetAvg().
+ */
+uint8_t AdcGetCount(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    return AdcCh[Channel - 1].Count;
+}
+#endif
 
 
 //==============================================================================
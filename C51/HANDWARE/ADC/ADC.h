@@ -35,6 +35,9 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "SYSTEM.h"
+#if ADC_SAMPLER_ENABLE
+#include "FILTER.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
@@ -54,6 +57,21 @@ typedef enum
     ADC_CHANNEL_7 = 7  ///< ADC channel 7.
 } AdcChannel;
 
+/**
+ * @def ADC_CHANNELS
+ * @brief Number of ADC channels.
+ */
+#define ADC_CHANNELS		7
+
+/**
+ * @brief All AD_VALUE words read in one DGUS burst.
+ */
+typedef struct
+{
+    uint16_t Value[ADC_CHANNELS];	///< AD_VALUE of each channel, index Channel - 1.
+    uint32_t Ticks;					///< TimeNowTicks() at the start of the burst.
+} AdcSnapshot;
+
 /**
  * @brief Enum for ADC operation status.
  */
@@ -75,12 +93,117 @@ uint16_t AdcRead(AdcChannel Channel);
 
 /**
  * @brief Reads and averages ADC values from the specified channel.
+ * @details Blocks for AvgCnt DGUS reads, which come faster than AD_VALUE
+ *          updates; prefer the background sampler (AdcGetAvg) where enabled.
  * @param Channel The ADC channel to read (1 to 7).
  * @param AvgCnt The number of samples to average.
  * @return uint16_t The averaged 16-bit ADC value.
  */
 uint16_t AdcReadAvg(AdcChannel Channel, uint16_t AvgCnt);
 
+/**
+ * @brief Reads all channels in one DGUS burst.
+ * @details One bus session instead of ADC_CHANNELS, and the values are
+ *          taken together instead of skewed by a session each.
+ * @param Snap Receives the values and the timestamp.
+ */
+void AdcReadAll(AdcSnapshot *Snap);
+
+#if ADC_BENCH_ENABLE
+/**
+ * @brief Measures the per-channel and the burst read paths on the target.
+ * @details Results go to ADC_BENCH_VP in Timer2 counts (FOSC/12), averaged by BENCH_TIME():
+ *          [0] all channels through AdcRead(), one call each,
+ *          [1] all channels through AdcReadAll(),
+ *          [2] Timer2 counts per millisecond.
+ *          Timer2 must be running.
+ */
+void AdcBench(void);
+#endif
+
+#if ADC_SAMPLER_ENABLE
+/**
+ * @brief Clears all channels of the background sampler.
+ */
+void AdcSamplerInit(void);
+
+/**
+ * @brief Starts background sampling of a channel.
+ * @details Every PeriodMs the AD_VALUE word is read once; 1 << DecimLog2 such
+ *          readings are averaged into one ring entry. Powers of two keep the
+ *          averaging to shifts. Restarting a channel clears it.
+ * @param Channel The ADC channel to sample (1 to 7).
+ * @param PeriodMs Sampling period in ms (0 is treated as 1).
+ * @param DecimLog2 Raw readings per ring entry, 1 << DecimLog2 (0 to 7, larger is treated as 7).
+ */
+void AdcSamplerStart(AdcChannel Channel, uint16_t PeriodMs, uint8_t DecimLog2);
+
+/**
+ * @brief Stops background sampling of a channel; its results stay readable.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void AdcSamplerStop(AdcChannel Channel);
+
+/**
+ * @brief Returns the last raw reading of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Last AD_VALUE, 0 before the first reading.
+ */
+uint16_t AdcGetLast(AdcChannel Channel);
+
+/**
+ * @brief Returns the running average of the ring (1 << ADC_RING_LOG2 decimated samples).
+ * @details The first ring entry fills every slot, so until the ring is full
+ *          the older slots hold that entry rather than weighing less.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Average, 0 before the first ring entry.
+ */
+uint16_t AdcGetAvg(AdcChannel Channel);
+
+/**
+ * @brief Returns the smallest raw reading since start or AdcResetMinMax().
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Minimum, 0xFFFF before the first reading.
+ */
+uint16_t AdcGetMin(AdcChannel Channel);
+
+/**
+ * @brief Returns the largest raw reading since start or AdcResetMinMax().
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Maximum, 0 before the first reading.
+ */
+uint16_t AdcGetMax(AdcChannel Channel);
+
+/**
+ * @brief Restarts min/max tracking of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void AdcResetMinMax(AdcChannel Channel);
+
+/**
+ * @brief Selects the filter run on every raw reading of a channel.
+ * @details The filter restarts and is primed by the next reading.
+ * @param Channel The ADC channel (1 to 7).
+ * @param Type Filter type (FILTER_NONE by default).
+ * @param Param Type parameter, see FilterType.
+ */
+void AdcSamplerFilter(AdcChannel Channel, FilterType Type, uint8_t Param);
+
+/**
+ * @brief Returns the filter output of a channel.
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint16_t Filtered value, 0 before the first reading.
+ */
+uint16_t AdcGetFiltered(AdcChannel Channel);
+
+/**
+ * @brief Returns the number of valid ring entries (saturates at 1 << ADC_RING_LOG2).
+ * @param Channel The ADC channel (1 to 7).
+ * @return uint8_t Entries averaged by AdcGetAvg().
+ */
+uint8_t AdcGetCount(AdcChannel Channel);
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
@@ -0,0 +1,226 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "ALARM.h"
+#include "ADC.h"
+#include "CALIB.h"
+#include "GPIO.h"
+#include "UART.h"
+#include "SoftTimer.h"
+
+#if ALARM_ENABLE
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define ALARM_ST_ACTIVE		0x01	///< Rule is raised.
+#define ALARM_ST_PENDING	0x02	///< Condition differs from the state, delay running since Since.
+#define ALARM_ST_SAMPLED	0x04	///< Value holds a sample.
+
+/**
+ * @brief Run-time state of one rule.
+ */
+typedef struct
+{
+    int16_t  Value;         ///< Last sampled input.
+    uint16_t Since;         ///< SoftTimerNow() when the pending delay started (mod 2^16).
+    uint8_t  Flags;         ///< ALARM_ST_*.
+} AlarmState;
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static xdata AlarmState AlarmSt[ALARM_RULES_MAX];			///< State, same index as AlarmRules.
+static xdata uint8_t AlarmNext;							///< Next rule to visit.
+static xdata uint8_t AlarmActive;							///< Raised rules.
+static xdata uint8_t AlarmTimer = SOFT_TIMER_NONE;		///< Evaluation tick.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Returns the number of rules in use.
+ * @return uint8_t AlarmRuleCount, limited to ALARM_RULES_MAX.
+ */
+static uint8_t AlarmRulesUsed(void)
+{
+    return (AlarmRuleCount > ALARM_RULES_MAX) ? ALARM_RULES_MAX : AlarmRuleCount;
+}
+
+/**
+ * @brief Samples the input of a rule.
+ * @param r The rule.
+ * @return int16_t Input value, see AlarmSource.
+ */
+static int16_t AlarmSample(AlarmRule *r)
+{
+    EPinState pin;
+
+    switch (r->Source)
+    {
+    case ALARM_SRC_ADC:
+#if ADC_SAMPLER_ENABLE
+        return CalConvert((AdcChannel)r->Input, AdcGetFiltered((AdcChannel)r->Input));
+#else
+        return CalConvert((AdcChannel)r->Input, AdcRead((AdcChannel)r->Input));
+#endif
+    case ALARM_SRC_GPIO:
+        if (GetGpioState((uint8_t)(r->Input >> 8), (uint8_t)r->Input, &pin) != GPIO_OK) return 0;
+        return (int16_t)pin;
+    default:
+        return (int16_t)ReadDgus(r->Input);
+    }
+}
+
+/**
+ * @brief Runs the actions of a rule that has just been raised or cleared.
+ * @param r The rule.
+ * @param Raised 1 on raise, 0 on clear.
+ */
+static void AlarmAction(AlarmRule *r, uint8_t Raised)
+{
+    if (r->Vp != ALARM_NO_VP)
+    {
+        WriteDgus(r->Vp, Raised);
+        if (r->Flags & ALARM_NOTIFY) UartUploadVp(r->Vp, Raised);
+    }
+    if (Raised && r->Page != ALARM_NO_PAGE) PageChange(r->Page);
+}
+
+/**
+ * @brief Samples one rule and advances its state.
+ * @param Rule Index in AlarmRules.
+ */
+static void AlarmVisit(uint8_t Rule)
+{
+    AlarmRule *r = &AlarmRules[Rule];
+    AlarmState *s = &AlarmSt[Rule];
+    int16_t v;
+    uint8_t active, want;
+    uint16_t now;
+
+    v = AlarmSample(r);
+    //Unchanged input and no delay running: nothing can change, skip the rest
+    if ((s->Flags & (ALARM_ST_SAMPLED | ALARM_ST_PENDING)) == ALARM_ST_SAMPLED && v == s->Value) return;
+    s->Value = v;
+    s->Flags |= ALARM_ST_SAMPLED;
+
+    active = s->Flags & ALARM_ST_ACTIVE;
+    if (r->Compare == ALARM_ABOVE)
+    {
+        want = active ? (v > r->Limit - r->Hyst) : (v > r->Limit);
+    }
+    else
+    {
+        want = active ? (v < r->Limit + r->Hyst) : (v < r->Limit);
+    }
+    if (want == active)
+    {
+        s->Flags &= ~ALARM_ST_PENDING;
+        return;
+    }
+
+    now = (uint16_t)SoftTimerNow();
+    if (!(s->Flags & ALARM_ST_PENDING))
+    {
+        s->Flags |= ALARM_ST_PENDING;
+        s->Since = now;
+    }
+    if ((uint16_t)(now - s->Since) < (active ? r->DelayOffMs : r->DelayOnMs)) return;
+
+    s->Flags = (s->Flags & ~ALARM_ST_PENDING) ^ ALARM_ST_ACTIVE;
+    if (want) AlarmActive++;
+    else AlarmActive--;
+    AlarmAction(r, want);
+}
+
+/**
+ * @brief Evaluation tick: visits the next ALARM_RULES_PER_TICK rules.
+ */
+static void AlarmTick(void)
+{
+    uint8_t n = AlarmRulesUsed();
+    uint8_t k;
+
+    for (k = 0; k < ALARM_RULES_PER_TICK && k < n; k++)
+    {
+        AlarmVisit(AlarmNext);
+        if (++AlarmNext >= n) AlarmNext = 0;
+    }
+}
+
+/**
+ * @brief Clears all alarms and starts the evaluation tick (none for an empty table).
+ */
+void AlarmInit(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < ALARM_RULES_MAX; i++)
+    {
+        AlarmSt[i].Flags = 0;
+    }
+    for (i = 0; i < AlarmRulesUsed(); i++)
+    {
+        if (AlarmRules[i].Vp != ALARM_NO_VP) WriteDgus(AlarmRules[i].Vp, 0);
+    }
+    AlarmNext = 0;
+    AlarmActive = 0;
+    if (AlarmRulesUsed() == 0) return;     //Empty table: no tick
+    if (AlarmTimer == SOFT_TIMER_NONE) AlarmTimer = SoftTimerStart(AlarmTick, ALARM_PERIOD_MS, ALARM_PERIOD_MS);
+}
+
+/**
+ * @brief Returns whether a rule is raised.
+ * @param Rule Index in AlarmRules.
+ * @return uint8_t 1 if raised, 0 if clear or out of range.
+ */
+uint8_t AlarmIsActive(uint8_t Rule)
+{
+    if (Rule >= AlarmRulesUsed()) return 0;
+    return AlarmSt[Rule].Flags & ALARM_ST_ACTIVE;
+}
+
+/**
+ * @brief Returns the number of raised alarms.
+ * @return uint8_t Raised rules.
+ */
+uint8_t AlarmActiveCount(void)
+{
+    return AlarmActive;
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,149 @@
+#ifndef __ALARM_H__
+#define __ALARM_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def ALARM_NO_VP
+ * @brief AlarmRule.Vp value for a rule without a VP action.
+ */
+#define ALARM_NO_VP			0xFFFF
+
+/**
+ * @def ALARM_NO_PAGE
+ * @brief AlarmRule.Page value for a rule without a page change.
+ */
+#define ALARM_NO_PAGE		0xFFFF
+
+/**
+ * @def ALARM_NOTIFY
+ * @brief AlarmRule.Flags: upload Vp as a 0x83 frame on every UART with DATA_UPLOAD set.
+ */
+#define ALARM_NOTIFY		0x01
+
+/**
+ * @def ALARM_GPIO
+ * @brief AlarmRule.Input of a GPIO source.
+ */
+#define ALARM_GPIO(port, pin)	(((uint16_t)(port) << 8) | (pin))
+
+/**
+ * @def ALARM_RULES_END
+ * @brief Last entry of AlarmRules, not counted in AlarmRuleCount.
+ * @details Keeps the array non-empty while the application has no rules.
+ */
+#define ALARM_RULES_END		{ ALARM_SRC_VP, 0, ALARM_ABOVE, 0, 0, 0, 0, ALARM_NO_VP, ALARM_NO_PAGE, 0 }
+
+/**
+ * @brief Enum for the input of a rule.
+ */
+typedef enum
+{
+    ALARM_SRC_ADC = 0,  ///< Input = AdcChannel, value = CalConvert() of the filtered reading.
+    ALARM_SRC_GPIO = 1, ///< Input = ALARM_GPIO(port, pin), value = 0 or 1.
+    ALARM_SRC_VP = 2,   ///< Input = VP address, value = the VP word as int16_t.
+} AlarmSource;
+
+/**
+ * @brief Enum for the direction of a rule.
+ */
+typedef enum
+{
+    ALARM_ABOVE = 0,    ///< Raised above Limit, cleared at or below Limit - Hyst.
+    ALARM_BELOW = 1,    ///< Raised below Limit, cleared at or above Limit + Hyst.
+} AlarmCompare;
+
+/**
+ * @brief One alarm rule; the application lists them in CODE (AlarmRules).
+ * @details Limit +- Hyst must stay within int16_t.
+ */
+typedef struct
+{
+    uint8_t  Source;        ///< AlarmSource.
+    uint16_t Input;         ///< Channel, pin or VP, see AlarmSource.
+    uint8_t  Compare;       ///< AlarmCompare.
+    int16_t  Limit;         ///< Raise threshold.
+    int16_t  Hyst;          ///< Hysteresis, >= 0.
+    uint16_t DelayOnMs;     ///< Time the condition must hold before the alarm is raised.
+    uint16_t DelayOffMs;    ///< Time the condition must be gone before the alarm is cleared.
+    uint16_t Vp;            ///< Set to 1 on raise and 0 on clear, or ALARM_NO_VP.
+    uint16_t Page;          ///< Page shown on raise, or ALARM_NO_PAGE.
+    uint8_t  Flags;         ///< ALARM_NOTIFY.
+} AlarmRule;
+
+/**
+ * @brief Alarm table of the application (up to ALARM_RULES_MAX rules are used).
+ */
+extern code AlarmRule AlarmRules[];
+
+/**
+ * @brief Number of rules in AlarmRules, ALARM_RULES_END excluded.
+ */
+extern code uint8_t AlarmRuleCount;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears all alarms and starts the evaluation tick.
+ * @details Every ALARM_PERIOD_MS the next ALARM_RULES_PER_TICK rules are
+ *          visited round-robin, so at most ALARM_RULES_PER_TICK * 1000 /
+ *          ALARM_PERIOD_MS rules (and VP reads) run per second. A visit
+ *          samples the input and stops there when it is unchanged and no
+ *          delay is running. Delays are resolved at the visit rate.
+ */
+void AlarmInit(void);
+
+/**
+ * @brief Returns whether a rule is raised.
+ * @param Rule Index in AlarmRules.
+ * @return uint8_t 1 if raised, 0 if clear or out of range.
+ */
+uint8_t AlarmIsActive(uint8_t Rule);
+
+/**
+ * @brief Returns the number of raised alarms.
+ * @return uint8_t Raised rules.
+ */
+uint8_t AlarmActiveCount(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,64 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file AlarmTable.c
+ * @brief Alarm rules of the application in CODE.
+ * @details One line per rule, evaluated by ALARM.c. GPIO inputs must be
+ *          configured with InitGpio() and ADC channels started with
+ *          AdcSamplerStart() by the application. The table ships empty;
+ *          the commented lines show one rule of each source.
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "ALARM.h"
+
+#if ALARM_ENABLE
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+code AlarmRule AlarmRules[] =
+{
+    //Source         Input                 Compare      Limit  Hyst  On ms  Off ms  Vp      Page           Flags
+    //{ ALARM_SRC_ADC,  2,                   ALARM_ABOVE, 3000,  100,  2000,  1000,   0x1100, ALARM_NO_PAGE, ALARM_NOTIFY },  ///< Channel 2 over 3.000 V.
+    //{ ALARM_SRC_GPIO, ALARM_GPIO(1, 0),    ALARM_BELOW, 1,     0,    50,    50,     0x1102, ALARM_NO_PAGE, ALARM_NOTIFY },  ///< P1.0 pulled low.
+    //{ ALARM_SRC_VP,   0x1110,              ALARM_ABOVE, 80,    5,    0,     0,      0x1103, ALARM_NO_PAGE, 0 },             ///< Host-written value over 80.
+    ALARM_RULES_END
+};
+
+code uint8_t AlarmRuleCount = sizeof(AlarmRules) / sizeof(AlarmRules[0]) - 1;
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -36,56 +36,178 @@ SOFTWARE.
 #include "SYSTEM.h"
 #include "UART.h"
 #include "TIMER.h"
+#include "SoftTimer.h"
+#include "SCHEDULER.h"
+#include "TimeStamp.h"
+#include "TRACE.h"
+#include "DIAG.h"
+#include "WDT.h"
+#include "ADC.h"
+#include "CALIB.h"
+#include "GPIO.h"
+#include "ALARM.h"
+#include "PID.h"
+#include "PWM.h"
+#include "INPUT.h"
+#include "PULSE.h"
+#include "SPI.h"
+#include "I2C.h"
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
+/**
+ * @def APP_UART_KEEPALIVE_MS
+ * @brief The UART task is woken at least this often so it can check in when idle.
+ */
+#define APP_UART_KEEPALIVE_MS	100
+
+/**
+ * @def APP_WDT_UART_MS
+ * @brief Watchdog deadline of the UART task.
+ */
+#define APP_WDT_UART_MS			300
+
+/**
+ * @def APP_WDT_APP_MS
+ * @brief Watchdog deadline of the once-per-second application task.
+ */
+#define APP_WDT_APP_MS			1500
 
 //==============================================================================
 //--------------------------------Variables-------------------------------------
 //==============================================================================
 
-xdata uint32_t SysTimCnt = 0;
-xdata uint32_t Uptime = 0;
-xdata uint32_t UptimeOld = 0;
 xdata uint16_t ReadPage = 0;
+#if WDT_SUP_ENABLE
+static xdata uint8_t AppWdtUart;	///< Supervisor handle of the UART task.
+static xdata uint8_t AppWdtApp;		///< Supervisor handle of the application task.
+#endif
 
 
+//==============================================================================
+//--------------------------------PROTOTYPE-------------------------------------
+//==============================================================================
+static void AppUartTask(void);
+#if WDT_SUP_ENABLE
+static void AppUartKeepAlive(void);
+#endif
+
 //==============================================================================
 //---------------------------------- INIT---------------------------------------
 //==============================================================================
 void AppInit()
 {
+	SchedInit();
+	SchedAddTask(SCHED_TASK_UART, AppUartTask);
+	SchedAddTask(SCHED_TASK_TIMER, SoftTimerProcess);
+	SchedAddTask(SCHED_TASK_APP, AppProcess);
 	UartInit();		
+	TimeInit();			//Time counters, before Timer2 starts
+	TraceInit();		//Event trace ring
+	SoftTimerInit();		//Software timers, driven by the Timer2 tick
+#if ADC_SAMPLER_ENABLE
+	AdcSamplerInit();		//Background ADC sampling, channels started with AdcSamplerStart()
+#endif
+	CalInit();				//ADC calibration curves: factory tables, then field data from NOR
+#if ALARM_ENABLE
+	//Start the ADC channels and configure the GPIO inputs of the AlarmTable.c rules here
+	AlarmInit();			//Alarm table, evaluated round-robin by a SoftTimer
+#endif
+#if PID_ENABLE
+	PidInit();				//PID loops, started with PidStart()
+#endif
+#if INPUT_ENABLE
+	InputInit();			//Debounced inputs, scanned by Timer2Isr
+#endif
+#if SPI_ENABLE
+	SpiInit();				//SPI master; devices added with SpiAttach()
+#endif
+#if I2C_ENABLE
+	I2cInit();				//I2C master, frees a bus left stuck by a reset
+#endif
   TimerInit();  			//Timer initialization
-	SysTimCnt = 0;
-	Uptime = 0;
+	DiagInit();			//Load and latency counters
+#if CRC_BENCH_ENABLE
+	Crc16Bench();
+#endif
+#if ADC_BENCH_ENABLE
+	AdcBench();
+#endif
+#if PWM_BENCH_ENABLE
+	PwmBench();
+#endif
+#if GPIO_BENCH_ENABLE
+	GpioBench();
+#endif
+#if PULSE_ENABLE
+#if PULSE_BENCH_ENABLE
+	PulseBench();			//Before PulseStart(): drives INT0 from software
+#endif
+	PulseInit();			//Pulse counters, published every PULSE_GATE_MS
+	PulseStart(0, PULSE_EDGE_FALLING);	//Flow meter on INT0
+	PulseStart(1, PULSE_EDGE_FALLING);	//Tachometer on INT1
+#endif
+#if SPI_ENABLE && SPI_BENCH_ENABLE
+	SpiBench();
+#endif
+#if I2C_ENABLE && I2C_BENCH_ENABLE
+	I2cBench();
+#endif
+#if WDT_SUP_ENABLE
+	WdtSupInit();		//Publish the last supervisor fault, then arm the watchdog
+	AppWdtUart = WdtSupRegister(SCHED_TASK_UART, APP_WDT_UART_MS);
+	AppWdtApp = WdtSupRegister(SCHED_TASK_APP, APP_WDT_APP_MS);
+	SoftTimerStart(AppUartKeepAlive, APP_UART_KEEPALIVE_MS, APP_UART_KEEPALIVE_MS);
+	WdtSupStart();
+#endif
 }
 
 
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
+/**
+ * @brief UART task: parses one frame per interface, re-arms while data is left.
+ */
+static void AppUartTask(void)
+{
+    DiagUartLatency(SchedGetStats(SCHED_TASK_UART)->LatencyLast);
+    WdtSupCheckIn(AppWdtUart);
+    UartProcess();
+    if (UartRxPending()) SchedSignal(SCHED_TASK_UART);
+}
+
+#if WDT_SUP_ENABLE
+/**
+ * @brief Wakes the UART task so it checks in with the watchdog while the line is idle.
+ */
+static void AppUartKeepAlive(void)
+{
+    SchedSignal(SCHED_TASK_UART);
+}
+#endif
+
+/**
+ * @brief Application task, signaled by Timer2Isr once per second.
+ */
 void AppProcess()
 {
-	if (UptimeOld != Uptime)
-  {
-    UptimeOld = Uptime;
-		ReadPage = GetPageID();
-		if (ReadPage == 1)
-		{
-			PageChange(0);
-		}
-		else if (ReadPage == 0)
-		{
-			PageChange(1);
-		}
-		else
-		{
-			PageChange(2);
-		}				  
+	WdtSupCheckIn(AppWdtApp);
+	DiagPublish();
+	ReadPage = GetPageID();
+	if (ReadPage == 1)
+	{
+		PageChange(0);
+	}
+	else if (ReadPage == 0)
+	{
+		PageChange(1);
+	}
+	else
+	{
+		PageChange(2);
 	}
-    UartProcess();
 }
 
 //==============================================================================
@@ -0,0 +1,179 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "CALIB.h"
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static xdata CalCurve CalActive[ADC_CHANNELS];					///< Curve in use, index Channel - 1.
+static xdata CalPoint CalField[ADC_CHANNELS][CAL_POINTS_MAX];	///< Field calibrations loaded from VP/NOR.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Selects the factory curves and applies the saved field calibrations.
+ */
+void CalInit(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < ADC_CHANNELS; i++)
+    {
+        CalActive[i] = CalDefault[i];
+    }
+#if CAL_NOR_ENABLE
+    CalLoadNor();           //On a NOR timeout the factory curves stay
+#endif
+}
+
+/**
+ * @brief Converts raw ADC counts to engineering units.
+ * @param Channel The ADC channel (1 to 7).
+ * @param Raw ADC counts.
+ * @return int16_t Engineering value.
+ */
+int16_t CalConvert(AdcChannel Channel, uint16_t Raw)
+{
+    CalPoint *p;
+    uint8_t lo, hi, mid;
+
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return 0;
+    if (CalActive[Channel - 1].Count < 2) return (Raw > 0x7FFF) ? 0x7FFF : (int16_t)Raw;
+    p = CalActive[Channel - 1].Points;
+    hi = CalActive[Channel - 1].Count - 1;
+
+    if (Raw <= p[0].Raw) return p[0].Value;
+    if (Raw >= p[hi].Raw) return p[hi].Value;
+
+    lo = 0;
+    while (hi - lo > 1)
+    {
+        mid = (lo + hi) >> 1;
+        if (p[mid].Raw <= Raw) lo = mid;
+        else hi = mid;
+    }
+    p += lo;
+    //|Slope * dRaw| stays below the segment step (<= 32767) in Q16, so int32_t cannot overflow
+    return p->Value + (int16_t)(((int32_t)(Raw - p->Raw) * p->Slope + 0x8000L) >> 16);
+}
+
+/**
+ * @brief Applies the field calibration of a channel from the CAL_VP block.
+ * @param Channel The ADC channel (1 to 7).
+ * @return StatusAdc ADC_OK, or ADC_ERR if the block is invalid.
+ */
+StatusAdc CalLoadVp(AdcChannel Channel)
+{
+    uint16_t buf[CAL_VP_STRIDE];
+    CalPoint *p;
+    int32_t dv;
+    uint8_t n, i;
+
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return ADC_ERR;
+
+    ReadDgusVp(CAL_VP + (uint16_t)(Channel - 1) * CAL_VP_STRIDE, (uint8_t*)buf, CAL_VP_STRIDE);
+    if (buf[0] == 0)
+    {
+        CalRestoreDefault(Channel);
+        return ADC_OK;
+    }
+    if (buf[0] < 2 || buf[0] > CAL_POINTS_MAX) return ADC_ERR;
+    n = (uint8_t)buf[0];
+
+    //Check everything before touching the table, it may be the one in use
+    for (i = 1; i < n; i++)
+    {
+        if (buf[1 + 2 * i] <= buf[1 + 2 * (i - 1)]) return ADC_ERR;
+        dv = (int32_t)(int16_t)buf[2 + 2 * i] - (int16_t)buf[2 + 2 * (i - 1)];
+        if (dv > 32767 || dv < -32767) return ADC_ERR;
+    }
+
+    p = CalField[Channel - 1];
+    for (i = 0; i < n; i++)
+    {
+        p[i].Raw = buf[1 + 2 * i];
+        p[i].Value = (int16_t)buf[2 + 2 * i];
+        p[i].Slope = 0;
+    }
+    for (i = 0; i + 1 < n; i++)
+    {
+        //The one division per segment, done here instead of in CalConvert()
+        dv = (int32_t)p[i + 1].Value - p[i].Value;
+        p[i].Slope = (dv * 65536L) / (int32_t)(p[i + 1].Raw - p[i].Raw);
+    }
+    CalActive[Channel - 1].Points = p;
+    CalActive[Channel - 1].Count = n;
+    return ADC_OK;
+}
+
+/**
+ * @brief Returns a channel to its factory curve.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void CalRestoreDefault(AdcChannel Channel)
+{
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return;
+    CalActive[Channel - 1] = CalDefault[Channel - 1];
+}
+
+/**
+ * @brief Reads the saved field calibrations from NOR into the CAL_VP block and applies them.
+ * @return StatusAdc ADC_OK, or ADC_ERR if the NOR read timed out (curves unchanged).
+ */
+StatusAdc CalLoadNor(void)
+{
+    uint8_t ch;
+
+    if (NorFlashRead(CAL_NOR_ADDR, CAL_VP, CAL_VP_WORDS) != NOR_OK) return ADC_ERR;
+    for (ch = ADC_CHANNEL_1; ch <= ADC_CHANNEL_7; ch++)
+    {
+        if (CalLoadVp((AdcChannel)ch) != ADC_OK) CalRestoreDefault((AdcChannel)ch);
+    }
+    return ADC_OK;
+}
+
+/**
+ * @brief Saves the CAL_VP block to NOR flash.
+ * @return StatusAdc ADC_OK, or ADC_ERR if the NOR write timed out.
+ */
+StatusAdc CalSaveNor(void)
+{
+    return (NorFlashWrite(CAL_NOR_ADDR, CAL_VP, CAL_VP_WORDS) == NOR_OK) ? ADC_OK : ADC_ERR;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,133 @@
+#ifndef __CALIB_H__
+#define __CALIB_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "ADC.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def CAL_VP_STRIDE
+ * @brief VP words per channel in the field calibration block:
+ *        point count, then Raw and Value of each point.
+ */
+#define CAL_VP_STRIDE		(1 + 2 * CAL_POINTS_MAX)
+
+/**
+ * @def CAL_VP_WORDS
+ * @brief Size of the field calibration block, rounded up to even for NOR access.
+ */
+#define CAL_VP_WORDS		((ADC_CHANNELS * CAL_VP_STRIDE + 1) & ~1)
+
+/**
+ * @brief One calibration point and the slope of the segment that starts at it.
+ */
+typedef struct
+{
+    uint16_t Raw;      ///< ADC counts, strictly increasing along a table.
+    int16_t  Value;    ///< Engineering value at Raw (unit and scale chosen per channel).
+    int32_t  Slope;    ///< Segment slope dValue/dRaw in Q16, 0 on the last point.
+} CalPoint;
+
+/**
+ * @brief Calibration curve of one channel.
+ */
+typedef struct
+{
+    CalPoint *Points;  ///< Points (CODE or XDATA), 0 when the channel is uncalibrated.
+    uint8_t  Count;    ///< Number of points, 0 or at least 2.
+} CalCurve;
+
+/**
+ * @brief Factory calibration curves in CODE, generated from a CSV by CalGen.
+ */
+extern code CalCurve CalDefault[ADC_CHANNELS];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Selects the factory curves and, if CAL_NOR_ENABLE, applies the field
+ *        calibrations saved in NOR flash.
+ */
+void CalInit(void);
+
+/**
+ * @brief Converts raw ADC counts to engineering units.
+ * @details Binary search for the segment, then one Q16 multiply; no division.
+ *          Inputs outside the table are clamped to its end values.
+ *          An uncalibrated channel returns Raw unchanged (saturated to int16_t).
+ * @param Channel The ADC channel (1 to 7).
+ * @param Raw ADC counts.
+ * @return int16_t Engineering value.
+ */
+int16_t CalConvert(AdcChannel Channel, uint16_t Raw);
+
+/**
+ * @brief Applies the field calibration of a channel from the CAL_VP block.
+ * @details The block holds the point count (2 to CAL_POINTS_MAX, 0 = factory
+ *          curve) and Raw/Value pairs with strictly increasing Raw and value
+ *          steps within +-32767. Slopes are computed here, once.
+ * @param Channel The ADC channel (1 to 7).
+ * @return StatusAdc ADC_OK, or ADC_ERR if the block is invalid (the curve is unchanged).
+ */
+StatusAdc CalLoadVp(AdcChannel Channel);
+
+/**
+ * @brief Returns a channel to its factory curve.
+ * @param Channel The ADC channel (1 to 7).
+ */
+void CalRestoreDefault(AdcChannel Channel);
+
+/**
+ * @brief Reads the saved field calibrations from NOR into the CAL_VP block and applies them.
+ * @details Channels whose saved block is empty or invalid keep the factory curve.
+ *          If the NOR read times out no curve is touched.
+ * @return StatusAdc ADC_OK, or ADC_ERR if the NOR read timed out.
+ */
+StatusAdc CalLoadNor(void);
+
+/**
+ * @brief Saves the CAL_VP block to NOR flash.
+ * @return StatusAdc ADC_OK, or ADC_ERR if the NOR write timed out.
+ */
+StatusAdc CalSaveNor(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file CalTable.c
+ * @brief Factory ADC calibration curves in CODE.
+ * @details Generated by TOOLS/CAL_GEN/CalGen from Calibration.csv; edit the CSV, not this file.
+ *          Columns: Raw, Value, Slope (dValue/dRaw in Q16 up to the next point).
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "CALIB.h"
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static code CalPoint CalCh1[8] =
+{
+    {   300,   1000,      -59578L },
+    {   520,    800,      -34492L },
+    {   900,    600,      -22598L },
+    {  1480,    400,      -17476L },
+    {  2230,    200,      -16384L },
+    {  3030,      0,      -21487L },
+    {  3640,   -200,      -42281L },
+    {  3950,   -400,           0L },
+};
+
+static code CalPoint CalCh2[2] =
+{
+    {     0,      0,       52812L },
+    {  4095,   3300,           0L },
+};
+
+code CalCurve CalDefault[ADC_CHANNELS] =
+{
+    { CalCh1, 8 },
+    { CalCh2, 2 },
+    { 0, 0 },          ///< Channel 3 uncalibrated: raw counts.
+    { 0, 0 },          ///< Channel 4 uncalibrated: raw counts.
+    { 0, 0 },          ///< Channel 5 uncalibrated: raw counts.
+    { 0, 0 },          ///< Channel 6 uncalibrated: raw counts.
+    { 0, 0 },          ///< Channel 7 uncalibrated: raw counts.
+};
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
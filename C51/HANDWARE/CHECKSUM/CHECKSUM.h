@@ -0,0 +1,123 @@
+#ifndef __CHECKSUM_H__
+#define __CHECKSUM_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def CHECKSUM_DGUS_CHUNK
+ * @brief Words read from DGUS per step in ChecksumUpdateDgus().
+ */
+#define CHECKSUM_DGUS_CHUNK		32
+
+/**
+ * @brief Enum for checksum algorithm selection.
+ */
+typedef enum
+{
+    CHECKSUM_CRC16_MODBUS = 0, ///< CRC-16/Modbus (poly 0x8005 reflected, init 0xFFFF), check 0x4B37.
+    CHECKSUM_CRC16_CCITT = 1,  ///< CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), check 0x29B1.
+    CHECKSUM_CRC32 = 2,        ///< CRC-32/IEEE 802.3 (poly 0x04C11DB7 reflected), check 0xCBF43926.
+} ChecksumType;
+
+/**
+ * @brief Running checksum state.
+ */
+typedef struct
+{
+    uint8_t  Type;             ///< ChecksumType of this state.
+    uint32_t Crc;              ///< Running register (16-bit algorithms use the low word).
+} Checksum;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Starts a new checksum.
+ * @param Ctx Checksum state.
+ * @param Type Algorithm.
+ */
+void ChecksumInit(Checksum* Ctx, ChecksumType Type);
+
+/**
+ * @brief Adds a block of bytes to a running checksum.
+ * @param Ctx Checksum state.
+ * @param pBuf Data.
+ * @param Len Number of bytes.
+ */
+void ChecksumUpdate(Checksum* Ctx, uint8_t* pBuf, uint16_t Len);
+
+/**
+ * @brief Adds bytes stored in a ring buffer, handling the wrap.
+ * @param Ctx Checksum state.
+ * @param pRing Ring buffer (e.g. Uartx_Define.RxBuffer).
+ * @param RingLen Ring buffer size.
+ * @param Start Index of the first byte.
+ * @param Len Number of bytes.
+ */
+void ChecksumUpdateRing(Checksum* Ctx, uint8_t* pRing, uint16_t RingLen, uint16_t Start, uint16_t Len);
+
+/**
+ * @brief Adds a block of DGUS VP words, read in CHECKSUM_DGUS_CHUNK steps.
+ * @param Ctx Checksum state.
+ * @param Addr First VP address.
+ * @param Len16 Number of 16-bit words.
+ */
+void ChecksumUpdateDgus(Checksum* Ctx, uint16_t Addr, uint16_t Len16);
+
+/**
+ * @brief Returns the final checksum value.
+ * @details The state is left untouched, so more data can still be added.
+ * @param Ctx Checksum state.
+ * @return uint32_t Checksum (16-bit algorithms in the low word).
+ */
+uint32_t ChecksumFinal(Checksum* Ctx);
+
+/**
+ * @brief Computes the checksum of one block.
+ * @param Type Algorithm.
+ * @param pBuf Data.
+ * @param Len Number of bytes.
+ * @return uint32_t Checksum (16-bit algorithms in the low word).
+ */
+uint32_t ChecksumBlock(ChecksumType Type, uint8_t* pBuf, uint16_t Len);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
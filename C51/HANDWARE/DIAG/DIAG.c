@@ -0,0 +1,210 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "DIAG.h"
+
+#if DIAG_ENABLE
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+xdata uint32_t DiagIsrStart;               ///< Entry time of the running ISR.
+xdata uint32_t DiagIsrTicks;               ///< Ticks spent in timed ISRs.
+
+static xdata uint32_t DiagWindowStart;     ///< Start of the current window.
+static xdata uint32_t DiagWindowIsr;       ///< DiagIsrTicks at the window start.
+static xdata uint32_t DiagLast;            ///< Time of the previous loop pass.
+static xdata uint32_t DiagLastIsr;         ///< DiagIsrTicks at the previous pass.
+static xdata uint32_t DiagBusy;            ///< Task time in the window, ISRs excluded.
+static xdata uint32_t DiagIdle;            ///< Idle time in the window, ISRs excluded.
+static xdata uint32_t DiagLoopMax;         ///< Longest pass that ran a task.
+static xdata uint32_t DiagUartMax;         ///< Longest UART latency.
+static xdata uint16_t DiagPasses;          ///< Passes that ran a task.
+static xdata uint16_t DiagLoopHist[DIAG_HIST_BUCKETS];
+static xdata uint16_t DiagUartHist[DIAG_HIST_BUCKETS];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Returns the log2 bucket of a tick count.
+ * @param Ticks Sample in Timer2 ticks.
+ * @return uint8_t Bucket index.
+ */
+static uint8_t DiagBucket(uint32_t Ticks)
+{
+    uint16_t v;
+    uint8_t b;
+
+    Ticks >>= 4;
+    if (Ticks >= (1UL << (DIAG_HIST_BUCKETS - 2))) return DIAG_HIST_BUCKETS - 1;
+    v = (uint16_t)Ticks;
+    b = 0;
+    if (v & 0xFF00) { v >>= 8; b = 8; }
+    while (v) { v >>= 1; b++; }
+    return b;
+}
+
+/**
+ * @brief Converts ticks to whole microseconds, saturated to 16 bits.
+ */
+static uint16_t DiagUs(uint32_t Ticks)
+{
+    Ticks = TimeTicksToUs(Ticks);
+    return Ticks > 0xFFFF ? 0xFFFF : (uint16_t)Ticks;
+}
+
+/**
+ * @brief Share of a window in per mille.
+ */
+static uint16_t DiagPermille(uint32_t Part, uint32_t Total)
+{
+    if (Total == 0) return 0;
+    if (Part >= Total) return 1000;
+    // Scale down first so Part * 1000 stays in 32 bits (Total < 2^32 ticks).
+    while (Total > 0x400000UL) { Total >>= 1; Part >>= 1; }
+    return (uint16_t)(Part * 1000 / Total);
+}
+
+/**
+ * @brief Clears the counters and starts the first window.
+ */
+void DiagInit(void)
+{
+    uint8_t i;
+
+    EA = 0;
+    TIME_NOW_TICKS_ISR(DiagLast);
+    DiagIsrTicks = 0;
+    EA = 1;
+    DiagLastIsr = 0;
+    DiagWindowStart = DiagLast;
+    DiagWindowIsr = 0;
+    DiagBusy = 0;
+    DiagIdle = 0;
+    DiagLoopMax = 0;
+    DiagUartMax = 0;
+    DiagPasses = 0;
+    for (i = 0; i < DIAG_HIST_BUCKETS; i++)
+    {
+        DiagLoopHist[i] = 0;
+        DiagUartHist[i] = 0;
+    }
+}
+
+/**
+ * @brief Accounts one main loop pass, call right after SchedRun().
+ * @details The time since the previous pass minus the ISR time in between
+ *          is charged to the tasks or to idle.
+ * @param ran Result of SchedRun(): the pass ran a task (1) or was idle (0).
+ */
+void DiagLoop(bit ran)
+{
+    uint32_t now, isr, pass;
+
+    EA = 0;
+    TIME_NOW_TICKS_ISR(now);
+    isr = DiagIsrTicks;
+    EA = 1;
+    pass = now - DiagLast;
+    DiagLast = now;
+    if (ran)
+    {
+        DiagBusy += pass - (isr - DiagLastIsr);
+        if (DiagPasses != 0xFFFF) DiagPasses++;
+        if (pass > DiagLoopMax) DiagLoopMax = pass;
+        pass = DiagBucket(pass);
+        if (DiagLoopHist[pass] != 0xFFFF) DiagLoopHist[pass]++;
+    }
+    else
+    {
+        DiagIdle += pass - (isr - DiagLastIsr);
+    }
+    DiagLastIsr = isr;
+}
+
+/**
+ * @brief Adds one UART task signal-to-run latency sample.
+ * @param Ticks Latency in Timer2 ticks.
+ */
+void DiagUartLatency(uint32_t Ticks)
+{
+    uint8_t b = DiagBucket(Ticks);
+
+    if (Ticks > DiagUartMax) DiagUartMax = Ticks;
+    if (DiagUartHist[b] != 0xFFFF) DiagUartHist[b]++;
+}
+
+/**
+ * @brief Writes the window to DIAG_VP and starts a new one. Call once per second.
+ */
+void DiagPublish(void)
+{
+    uint16_t xdata block[DIAG_VP_WORDS];
+    uint32_t now, isr, total;
+    uint8_t i;
+
+    EA = 0;
+    TIME_NOW_TICKS_ISR(now);
+    isr = DiagIsrTicks;
+    EA = 1;
+    total = now - DiagWindowStart;
+
+    block[0] = DiagPermille(isr - DiagWindowIsr, total);
+    block[1] = DiagPermille(DiagBusy, total);
+    block[2] = DiagPermille(DiagIdle, total);
+    block[3] = DiagPasses;
+    block[4] = DiagUs(DiagLoopMax);
+    block[5] = DiagUs(DiagUartMax);
+    for (i = 0; i < DIAG_HIST_BUCKETS; i++)
+    {
+        block[6 + i] = DiagLoopHist[i];
+        block[6 + DIAG_HIST_BUCKETS + i] = DiagUartHist[i];
+        DiagLoopHist[i] = 0;
+        DiagUartHist[i] = 0;
+    }
+    WriteDgusVp(DIAG_VP, (uint8_t*)block, DIAG_VP_WORDS);
+
+    DiagWindowStart = now;
+    DiagWindowIsr = isr;
+    DiagBusy = 0;
+    DiagIdle = 0;
+    DiagLoopMax = 0;
+    DiagUartMax = 0;
+    DiagPasses = 0;
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,137 @@
+#ifndef __DIAG_H__
+#define __DIAG_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "TimeStamp.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def DIAG_HIST_BUCKETS
+ * @brief log2 histogram buckets.
+ * @details Samples are taken in units of 16 Timer2 ticks (~0.93 us); bucket 0
+ *          holds samples under one unit, bucket n holds [2^(n-1), 2^n) units
+ *          and the last bucket everything above (~15 ms and up).
+ */
+#define DIAG_HIST_BUCKETS		16
+
+/**
+ * @def DIAG_VP_WORDS
+ * @brief Size of the block published at DIAG_VP.
+ * @details Word layout:
+ *          0  ISR time, per mille of the last second
+ *          1  task time, per mille
+ *          2  idle time, per mille
+ *          3  loop passes that ran a task
+ *          4  longest such pass, us (saturated)
+ *          5  longest UART signal-to-run latency, us (saturated)
+ *          6  loop pass histogram (DIAG_HIST_BUCKETS words)
+ *          22 UART latency histogram (DIAG_HIST_BUCKETS words)
+ */
+#define DIAG_VP_WORDS			(6 + 2 * DIAG_HIST_BUCKETS)
+
+#if DIAG_ENABLE
+/**
+ * @def DIAG_ISR_ENTER
+ * @brief Starts timing an ISR.
+ * @details Only the low priority ISRs are timed and they do not nest, so one
+ *          start time is enough. The untimed high priority pulse edge ISRs
+ *          (PULSE_EDGE_ISR) may preempt them; that time is then counted as
+ *          ISR time, otherwise as task or idle time.
+ */
+#define DIAG_ISR_ENTER()		TIME_NOW_TICKS_ISR(DiagIsrStart)
+
+/**
+ * @def DIAG_ISR_EXIT
+ * @brief Adds the time since DIAG_ISR_ENTER() to the ISR total.
+ */
+#define DIAG_ISR_EXIT() \
+{ \
+    uint32_t t_; \
+    TIME_NOW_TICKS_ISR(t_); \
+    DiagIsrTicks += t_ - DiagIsrStart; \
+}
+#else
+#define DIAG_ISR_ENTER()
+#define DIAG_ISR_EXIT()
+#endif
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Entry time of the running ISR. */
+extern xdata uint32_t DiagIsrStart;
+
+/** @brief Ticks spent in timed ISRs (wraps). */
+extern xdata uint32_t DiagIsrTicks;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if DIAG_ENABLE
+/**
+ * @brief Clears the counters and starts the first window.
+ */
+void DiagInit(void);
+
+/**
+ * @brief Accounts one main loop pass, call right after SchedRun().
+ * @param ran Result of SchedRun(): the pass ran a task (1) or was idle (0).
+ */
+void DiagLoop(bit ran);
+
+/**
+ * @brief Adds one UART task signal-to-run latency sample.
+ * @param Ticks Latency in Timer2 ticks.
+ */
+void DiagUartLatency(uint32_t Ticks);
+
+/**
+ * @brief Writes the window to DIAG_VP and starts a new one. Call once per second.
+ */
+void DiagPublish(void);
+#else
+#define DiagInit()
+#define DiagLoop(ran)			(ran)
+#define DiagUartLatency(Ticks)
+#define DiagPublish()
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,173 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "FILTER.h"
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Sets up a filter; the first sample fed primes its whole history.
+ * @param f Filter state.
+ * @param Type Filter type.
+ * @param Param Type parameter, see FilterType.
+ */
+void FilterInit(Filter* f, FilterType Type, uint8_t Param)
+{
+    switch (Type)
+    {
+        case FILTER_IIR:
+            if (Param == 0) Param = 1;
+            if (Param > 15) Param = 15;
+            break;
+        case FILTER_AVERAGE:
+            if (Param > FILTER_MA_BITS_MAX) Param = FILTER_MA_BITS_MAX;
+            break;
+        case FILTER_MEDIAN:
+            if (Param > FILTER_MEDIAN_MAX) Param = FILTER_MEDIAN_MAX;
+            Param |= 1;
+            break;
+        default:
+            Type = FILTER_NONE;
+            Param = 0;
+            break;
+    }
+    f->Type = Type;
+    f->Param = Param;
+    FilterReset(f);
+}
+
+/**
+ * @brief Restarts a filter with its current settings; the next sample primes it.
+ * @param f Filter state.
+ */
+void FilterReset(Filter* f)
+{
+    f->Primed = 0;
+    f->Head = 0;
+    f->Out = 0;
+    f->Acc = 0;
+}
+
+/**
+ * @brief Fills the history with one sample, so the filter starts settled on it.
+ * @param f Filter state.
+ * @param x First sample.
+ */
+static void FilterPrime(Filter* f, uint16_t x)
+{
+    uint8_t i;
+
+    for (i = 0; i < FILTER_BUF_LEN; i++) f->Buf[i] = x;
+    for (i = 0; i < FILTER_MEDIAN_MAX; i++) f->Sorted[i] = x;
+    f->Acc = (uint32_t)x << f->Param;	//IIR: y * 2^k; AVERAGE: sum of 2^Param copies
+    f->Head = 0;
+    f->Primed = 1;
+}
+
+/**
+ * @brief Feeds one sample to a median filter.
+ * @details The oldest sample is taken out of the sorted window and the new
+ *          one slid into place in a single pass, so no sort is ever run.
+ * @param f Filter state.
+ * @param x Input sample.
+ * @return uint16_t Median of the window.
+ */
+static uint16_t FilterMedian(Filter* f, uint16_t x)
+{
+    uint8_t n = f->Param;
+    uint8_t i = 0;
+    uint16_t old = f->Buf[f->Head];
+
+    f->Buf[f->Head] = x;
+    if (++f->Head >= n) f->Head = 0;
+
+    while (f->Sorted[i] != old) i++;	//Always found: the window holds it
+    if (x > old)
+    {
+        while (i + 1 < n && f->Sorted[i + 1] < x)
+        {
+            f->Sorted[i] = f->Sorted[i + 1];
+            i++;
+        }
+    }
+    else
+    {
+        while (i > 0 && f->Sorted[i - 1] > x)
+        {
+            f->Sorted[i] = f->Sorted[i - 1];
+            i--;
+        }
+    }
+    f->Sorted[i] = x;
+    return f->Sorted[n >> 1];
+}
+
+/**
+ * @brief Feeds one sample.
+ * @param f Filter state.
+ * @param x Input sample.
+ * @return uint16_t Filter output.
+ */
+uint16_t FilterUpdate(Filter* f, uint16_t x)
+{
+    if (!f->Primed) FilterPrime(f, x);
+
+    switch (f->Type)
+    {
+        case FILTER_IIR:
+            //Acc holds y * 2^k: Acc += x - y keeps the fraction, so the output settles exactly on x
+            f->Acc = f->Acc - (f->Acc >> f->Param) + x;
+            f->Out = (uint16_t)(f->Acc >> f->Param);
+            break;
+        case FILTER_AVERAGE:
+            f->Acc += x;
+            f->Acc -= f->Buf[f->Head];
+            f->Buf[f->Head] = x;
+            f->Head = (f->Head + 1) & ((1 << f->Param) - 1);
+            f->Out = (uint16_t)(f->Acc >> f->Param);
+            break;
+        case FILTER_MEDIAN:
+            f->Out = FilterMedian(f, x);
+            break;
+        default:
+            f->Out = x;
+            break;
+    }
+    return f->Out;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
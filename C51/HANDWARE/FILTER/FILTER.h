@@ -0,0 +1,122 @@
+#ifndef __FILTER_H__
+#define __FILTER_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#if (FILTER_MEDIAN_MAX & 1) == 0
+#error "FILTER_MEDIAN_MAX must be odd: FilterInit() rounds median windows up to odd"
+#endif
+
+/**
+ * @def FILTER_BUF_LEN
+ * @brief History words kept in each filter (moving-average ring or median window).
+ */
+#if (1 << FILTER_MA_BITS_MAX) > FILTER_MEDIAN_MAX
+#define FILTER_BUF_LEN		(1 << FILTER_MA_BITS_MAX)
+#else
+#define FILTER_BUF_LEN		FILTER_MEDIAN_MAX
+#endif
+
+/**
+ * @brief Enum for filter type selection.
+ * @details Param of FilterInit() per type:
+ *          IIR     - shift k, y += (x - y) / 2^k (1 to 15, time constant ~2^k samples),
+ *          AVERAGE - log2 of the window, 2^Param samples (0 to FILTER_MA_BITS_MAX),
+ *          MEDIAN  - window, odd (1 to FILTER_MEDIAN_MAX).
+ */
+typedef enum
+{
+    FILTER_NONE = 0,    ///< Output follows the input.
+    FILTER_IIR = 1,     ///< First-order low-pass, no division.
+    FILTER_AVERAGE = 2, ///< Power-of-two moving average, running sum and shift.
+    FILTER_MEDIAN = 3,  ///< Small-window median, rejects single-sample spikes.
+} FilterType;
+
+/**
+ * @brief Filter state; allocated by the caller, no other memory is used.
+ */
+typedef struct
+{
+    uint8_t  Type;                      ///< FilterType.
+    uint8_t  Param;                     ///< Type parameter, validated by FilterInit().
+    uint8_t  Primed;                    ///< 0 until the first sample has filled the history.
+    uint8_t  Head;                      ///< Oldest history entry.
+    uint16_t Out;                       ///< Last output.
+    uint32_t Acc;                       ///< IIR state (y * 2^k) or moving-average sum.
+    uint16_t Buf[FILTER_BUF_LEN];       ///< History in arrival order.
+    uint16_t Sorted[FILTER_MEDIAN_MAX]; ///< Median window in ascending order.
+} Filter;
+
+/**
+ * @def FilterOut
+ * @brief Last output of a filter, without feeding a sample.
+ */
+#define FilterOut(f)		((f)->Out)
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Sets up a filter; the first sample fed primes its whole history.
+ * @details Out-of-range Param is clamped (an even median window is rounded up).
+ * @param f Filter state.
+ * @param Type Filter type.
+ * @param Param Type parameter, see FilterType.
+ */
+void FilterInit(Filter* f, FilterType Type, uint8_t Param);
+
+/**
+ * @brief Restarts a filter with its current settings; the next sample primes it.
+ * @param f Filter state.
+ */
+void FilterReset(Filter* f);
+
+/**
+ * @brief Feeds one sample.
+ * @details Costs O(1) for IIR and AVERAGE, O(window) for MEDIAN. No division.
+ * @param f Filter state.
+ * @param x Input sample.
+ * @return uint16_t Filter output.
+ */
+uint16_t FilterUpdate(Filter* f, uint16_t x);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
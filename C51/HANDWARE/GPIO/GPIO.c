@@ -33,10 +33,118 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "GPIO.h"
+#if GPIO_BENCH_ENABLE
+#include <intrins.h>
+#include "TimeStamp.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
+#if GPIO_BENCH_ENABLE
+#define GPIO_BENCH_PIN			GPIO_PORT_3, GPIO_PIN_3	///< Pin written by GpioBench().
+#endif
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static code uint8_t GpioPinMask[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};	///< Bit of each pin.
+static code uint8_t GpioPortPins[4] = {0xFF, 0xFF, 0xFF, 0x0F};						///< Pins present on each port.
+
+//==============================================================================
+//--------------------------------PORT ACCESS-----------------------------------
+//==============================================================================
+// SFRs are reached by direct addressing only, so a run-time port number
+// becomes one switch; everything else is a table lookup.
+
+/**
+ * @brief Returns the mask of a pin, 0 if the port or pin does not exist.
+ * @param Port The port number (0 to 3).
+ * @param Pin The pin number.
+ * @return uint8_t Pin bit or 0.
+ */
+static uint8_t GpioMask(uint8_t Port, uint8_t Pin)
+{
+    if (Port > GPIO_PORT_3 || Pin > GPIO_PIN_7) return 0;
+    return GpioPinMask[Pin] & GpioPortPins[Port];
+}
+
+/**
+ * @brief Sets or clears bits of a PxMDOUT register.
+ * @param Port The port number (0 to 3).
+ * @param Mask Bits to change.
+ * @param Value New bit values.
+ */
+static void GpioModeMask(uint8_t Port, uint8_t Mask, uint8_t Value)
+{
+    bit ea = EA;
+
+    EA = 0;
+    switch (Port)
+    {
+    case GPIO_PORT_0: P0MDOUT = (P0MDOUT & ~Mask) | (Value & Mask); break;
+    case GPIO_PORT_1: P1MDOUT = (P1MDOUT & ~Mask) | (Value & Mask); break;
+    case GPIO_PORT_2: P2MDOUT = (P2MDOUT & ~Mask) | (Value & Mask); break;
+    case GPIO_PORT_3: P3MDOUT = (P3MDOUT & ~Mask) | (Value & Mask); break;
+    }
+    EA = ea;
+}
+
+/**
+ * @brief Reads all pins of a port.
+ * @param Port The port number (0 to 3).
+ * @return uint8_t Pin levels, bit n = pin n (0 for a bad port).
+ */
+uint8_t GpioPortRead(uint8_t Port)
+{
+    switch (Port)
+    {
+    case GPIO_PORT_0: return P0;
+    case GPIO_PORT_1: return P1;
+    case GPIO_PORT_2: return P2;
+    case GPIO_PORT_3: return P3 & GpioPortPins[GPIO_PORT_3];
+    }
+    return 0;
+}
+
+/**
+ * @brief Changes the masked latches of a port, with interrupts off.
+ * @details One ANL and one ORL on the port latch (GPIO_LATCH_CLR/SET), so
+ *          pins outside Mask keep their latch whatever level they read.
+ * @param Port The port number (0 to 3).
+ * @param Mask Pins to change; pins the port does not have are ignored.
+ * @param Value New levels of the masked pins.
+ * @return EGpioStatus GPIO_OK on success, GPIO_ERR on invalid port.
+ */
+EGpioStatus GpioPortMask(uint8_t Port, uint8_t Mask, uint8_t Value)
+{
+    bit ea;
+
+    if (Port > GPIO_PORT_3) return GPIO_ERR;
+    Mask &= GpioPortPins[Port];
+    ea = EA;
+    EA = 0;
+    switch (Port)
+    {
+    case GPIO_PORT_0: GPIO_LATCH_CLR(GPIO_PORT_0, Mask & ~Value); GPIO_LATCH_SET(GPIO_PORT_0, Mask & Value); break;
+    case GPIO_PORT_1: GPIO_LATCH_CLR(GPIO_PORT_1, Mask & ~Value); GPIO_LATCH_SET(GPIO_PORT_1, Mask & Value); break;
+    case GPIO_PORT_2: GPIO_LATCH_CLR(GPIO_PORT_2, Mask & ~Value); GPIO_LATCH_SET(GPIO_PORT_2, Mask & Value); break;
+    case GPIO_PORT_3: GPIO_LATCH_CLR(GPIO_PORT_3, Mask & ~Value); GPIO_LATCH_SET(GPIO_PORT_3, Mask & Value); break;
+    }
+    EA = ea;
+    return GPIO_OK;
+}
+
+/**
+ * @brief Writes all pins of a port.
+ * @param Port The port number (0 to 3).
+ * @param Value Pin levels, bit n = pin n.
+ * @return EGpioStatus GPIO_OK on success, GPIO_ERR on invalid port.
+ */
+EGpioStatus GpioPortWrite(uint8_t Port, uint8_t Value)
+{
+    return GpioPortMask(Port, 0xFF, Value);
+}
 
 //==============================================================================
 //----------------------------------INIT---------------------------------------
@@ -51,22 +159,19 @@ SOFTWARE.
  */
 EGpioStatus InitGpio(EPinType Type, uint8_t Port, uint8_t Pin, EPinState StatePin)
 {
+    uint8_t mask = GpioMask(Port, Pin);
+
+    if (mask == 0) return GPIO_ERR;
     if (Type == GPIO_OUT)
     {
-        if (Port == GPIO_PORT_0) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P0MDOUT |= (1 << Pin); }
-        else if (Port == GPIO_PORT_1) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P1MDOUT |= (1 << Pin); }
-        else if (Port == GPIO_PORT_2) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P2MDOUT |= (1 << Pin); }
-        else if (Port == GPIO_PORT_3) { if (Pin > GPIO_PIN_3) { return GPIO_ERR; } P3MDOUT |= (1 << Pin); }
-        else { return GPIO_ERR; }
-        SetGpioOutState(Port, Pin, StatePin);
+        GpioPortMask(Port, mask, (StatePin == GPIO_HIGHT) ? 0xFF : 0x00);
+        GpioModeMask(Port, mask, 0xFF);
     }
     else if (Type == GPIO_IN)
     {
-        if (Port == GPIO_PORT_0) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P0MDOUT &= ~(1 << Pin); }
-        else if (Port == GPIO_PORT_1) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P1MDOUT &= ~(1 << Pin); }
-        else if (Port == GPIO_PORT_2) { if (Pin > GPIO_PIN_7) { return GPIO_ERR; } P2MDOUT &= ~(1 << Pin); }
-        else if (Port == GPIO_PORT_3) { if (Pin > GPIO_PIN_3) { return GPIO_ERR; } P3MDOUT &= ~(1 << Pin); }
-        else { return GPIO_ERR; }
+        //Open-drain with the latch high: the pin floats and can be read
+        GpioModeMask(Port, mask, 0x00);
+        GpioPortMask(Port, mask, 0xFF);
     }
     else
     {
@@ -87,61 +192,11 @@ EGpioStatus InitGpio(EPinType Type, uint8_t Port, uint8_t Pin, EPinState StatePi
  */
 EGpioStatus GetGpioState(uint8_t Port, uint8_t Pin, EPinState* StatePin)
 {
-    uint16_t state = 0;
-    uint8_t returnStatus = GPIO_OK;
-
-    if (Port == GPIO_PORT_0)
-    {
-        if (Pin == GPIO_PIN_0) { if ((P0 & 0x01) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_1) { if ((P0 & 0x02) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_2) { if ((P0 & 0x04) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_3) { if ((P0 & 0x08) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_4) { if ((P0 & 0x10) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_5) { if ((P0 & 0x20) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_6) { if ((P0 & 0x40) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_7) { if ((P0 & 0x80) != 0) state = 1; else state = 0; }
-        else return GPIO_ERR;
-    }
-    else if (Port == GPIO_PORT_1)
-    {
-        if (Pin == GPIO_PIN_0) { if ((P1 & 0x01) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_1) { if ((P1 & 0x02) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_2) { if ((P1 & 0x04) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_3) { if ((P1 & 0x08) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_4) { if ((P1 & 0x10) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_5) { if ((P1 & 0x20) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_6) { if ((P1 & 0x40) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_7) { if ((P1 & 0x80) != 0) state = 1; else state = 0; }
-        else return GPIO_ERR;
-    }
-    else if (Port == GPIO_PORT_2)
-    {
-        if (Pin == GPIO_PIN_0) { if ((P2 & 0x01) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_1) { if ((P2 & 0x02) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_2) { if ((P2 & 0x04) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_3) { if ((P2 & 0x08) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_4) { if ((P2 & 0x10) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_5) { if ((P2 & 0x20) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_6) { if ((P2 & 0x40) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_7) { if ((P2 & 0x80) != 0) state = 1; else state = 0; }
-        else return GPIO_ERR;
-    }
-    else if (Port == GPIO_PORT_3)
-    {
-        if (Pin == GPIO_PIN_0) { if ((P3 & 0x01) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_1) { if ((P3 & 0x02) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_2) { if ((P3 & 0x04) != 0) state = 1; else state = 0; }
-        else if (Pin == GPIO_PIN_3) { if ((P3 & 0x08) != 0) state = 1; else state = 0; }
-        else return GPIO_ERR;
-    }
-    else
-    {
-        return GPIO_ERR;
-    }
+    uint8_t mask = GpioMask(Port, Pin);
 
-    if (state != 0) *StatePin = GPIO_LOW;
-    else *StatePin = GPIO_HIGHT;
-    return returnStatus;
+    if (mask == 0) return GPIO_ERR;
+    *StatePin = (GpioPortRead(Port) & mask) ? GPIO_HIGHT : GPIO_LOW;
+    return GPIO_OK;
 }
 
 /**
@@ -152,6 +207,21 @@ EGpioStatus GetGpioState(uint8_t Port, uint8_t Pin, EPinState* StatePin)
  * @return EGpioStatus GPIO_OK on success, GPIO_ERR on invalid port or pin.
  */
 EGpioStatus SetGpioOutState(uint8_t Port, uint8_t Pin, EPinState State)
+{
+    uint8_t mask = GpioMask(Port, Pin);
+
+    if (mask == 0) return GPIO_ERR;
+    return GpioPortMask(Port, mask, (State == GPIO_HIGHT) ? 0xFF : 0x00);
+}
+
+#if GPIO_BENCH_ENABLE
+//==============================================================================
+//----------------------------------BENCH---------------------------------------
+//==============================================================================
+/**
+ * @brief The if/else ladder SetGpioOutState() used before the tables, kept as the reference.
+ */
+static EGpioStatus GpioBenchLadder(uint8_t Port, uint8_t Pin, EPinState State)
 {
     if (Port == GPIO_PORT_0)
     {
@@ -204,6 +274,37 @@ EGpioStatus SetGpioOutState(uint8_t Port, uint8_t Pin, EPinState State)
     return GPIO_OK;
 }
 
+/**
+ * @brief Times writes of P3.3 through each path (BENCH_TIME()).
+ * @details Results (ticks per write) go to GPIO_BENCH_VP: [0] previous
+ *          ladder, [1] SetGpioOutState(), [2] GPIO_WRITE() on a constant
+ *          pin, [3] TIME_TICKS_PER_MS. P3.3 is the worst case of the ladder;
+ *          every write stores the value its latch already holds. The
+ *          latch, not the pin level, is taken: P3.3 is also INT1, and a
+ *          pulled-up input read low must not get a 0 in its latch.
+ */
+void GpioBench(void)
+{
+    uint16_t result[4];
+    EPinState st;
+    uint8_t run;
+    bit ea = EA;
+    bit latch;
+
+    //JBC (_testbit_) reads the latch; it clears the bit, which is set back at once
+    EA = 0;
+    latch = _testbit_(GPIO_P3_3);
+    GPIO_P3_3 = latch;
+    EA = ea;
+    st = latch ? GPIO_HIGHT : GPIO_LOW;
+
+    BENCH_TIME(result[0], run, GpioBenchLadder(GPIO_PORT_3, GPIO_PIN_3, st));
+    BENCH_TIME(result[1], run, SetGpioOutState(GPIO_PORT_3, GPIO_PIN_3, st));
+    BENCH_TIME(result[2], run, GPIO_WRITE(GPIO_BENCH_PIN, st));
+    BenchReport(GPIO_BENCH_VP, result, 3);
+}
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
-//==============================================================================
\ No newline at end of file
+//==============================================================================
@@ -52,6 +52,101 @@ SOFTWARE.
 #define GPIO_PIN_6				6
 #define GPIO_PIN_7				7
 
+/**
+ * @brief One bit variable per pin, used by the constant-pin macros below.
+ */
+sbit GPIO_P0_0 = P0^0;
+sbit GPIO_P0_1 = P0^1;
+sbit GPIO_P0_2 = P0^2;
+sbit GPIO_P0_3 = P0^3;
+sbit GPIO_P0_4 = P0^4;
+sbit GPIO_P0_5 = P0^5;
+sbit GPIO_P0_6 = P0^6;
+sbit GPIO_P0_7 = P0^7;
+sbit GPIO_P1_0 = P1^0;
+sbit GPIO_P1_1 = P1^1;
+sbit GPIO_P1_2 = P1^2;
+sbit GPIO_P1_3 = P1^3;
+sbit GPIO_P1_4 = P1^4;
+sbit GPIO_P1_5 = P1^5;
+sbit GPIO_P1_6 = P1^6;
+sbit GPIO_P1_7 = P1^7;
+sbit GPIO_P2_0 = P2^0;
+sbit GPIO_P2_1 = P2^1;
+sbit GPIO_P2_2 = P2^2;
+sbit GPIO_P2_3 = P2^3;
+sbit GPIO_P2_4 = P2^4;
+sbit GPIO_P2_5 = P2^5;
+sbit GPIO_P2_6 = P2^6;
+sbit GPIO_P2_7 = P2^7;
+sbit GPIO_P3_0 = P3^0;
+sbit GPIO_P3_1 = P3^1;
+sbit GPIO_P3_2 = P3^2;
+sbit GPIO_P3_3 = P3^3;
+
+/**
+ * @def GPIO_SET
+ * @brief Drives a constant pin high: one SETB.
+ * @details Pins are compile-time descriptors expanding to "port, pin", e.g.
+ *          @code #define LED_RUN  GPIO_PORT_1, GPIO_PIN_5 @endcode
+ *          then GPIO_SET(LED_RUN). The extra macro level splits the
+ *          descriptor; a pin the board does not have is a compile error.
+ *          Use the functions for pins known only at run time.
+ */
+#define GPIO_SET(Pin)			GPIO_SET_(Pin)
+#define GPIO_SET_(Port, Pin)	(GPIO_P##Port##_##Pin = 1)
+
+/**
+ * @def GPIO_CLR
+ * @brief Drives a constant pin low: one CLR.
+ */
+#define GPIO_CLR(Pin)			GPIO_CLR_(Pin)
+#define GPIO_CLR_(Port, Pin)	(GPIO_P##Port##_##Pin = 0)
+
+/**
+ * @def GPIO_WRITE
+ * @brief Drives a constant pin to a level (0 or non-zero): one bit move.
+ */
+#define GPIO_WRITE(Pin, Level)	GPIO_WRITE_(Pin, Level)
+#define GPIO_WRITE_(Port, Pin, Level)	(GPIO_P##Port##_##Pin = (Level) ? 1 : 0)
+
+/**
+ * @def GPIO_READ
+ * @brief Level of a constant pin as a bit (1 = high).
+ */
+#define GPIO_READ(Pin)			GPIO_READ_(Pin)
+#define GPIO_READ_(Port, Pin)	(GPIO_P##Port##_##Pin)
+
+/**
+ * @def GPIO_TOGGLE
+ * @brief Inverts a constant pin: one CPL.
+ */
+#define GPIO_TOGGLE(Pin)		GPIO_TOGGLE_(Pin)
+#define GPIO_TOGGLE_(Port, Pin)	(GPIO_P##Port##_##Pin = !GPIO_P##Port##_##Pin)
+
+/**
+ * @def GPIO_LATCH_CLR
+ * @brief Clears latch bits of a constant port: one ANL Px.
+ * @details A plain read of Px (MOV A,Px) returns the pin levels; only the
+ *          read-modify-write instructions (ANL/ORL/XRL Px, SETB/CLR/CPL)
+ *          work on the latch. Writing back a pin read would copy any input
+ *          held low from outside into its latch and keep it low for good,
+ *          so multi-pin updates go through these two macros.
+ * @param Port GPIO_PORT_x.
+ * @param Bits Latch bits to clear.
+ */
+#define GPIO_LATCH_CLR(Port, Bits)		GPIO_LATCH_CLR_(Port, Bits)
+#define GPIO_LATCH_CLR_(Port, Bits)		(P##Port &= (uint8_t)~(Bits))
+
+/**
+ * @def GPIO_LATCH_SET
+ * @brief Sets latch bits of a constant port: one ORL Px.
+ * @param Port GPIO_PORT_x.
+ * @param Bits Latch bits to set.
+ */
+#define GPIO_LATCH_SET(Port, Bits)		GPIO_LATCH_SET_(Port, Bits)
+#define GPIO_LATCH_SET_(Port, Bits)		(P##Port |= (Bits))
+
 /**
  * @brief Enum for GPIO operation status.
  */
@@ -110,6 +205,39 @@ EGpioStatus GetGpioState(uint8_t Port, uint8_t Pin, EPinState* StatePin);
  */
 EGpioStatus SetGpioOutState(uint8_t Port, uint8_t Pin, EPinState State);
 
+/**
+ * @brief Reads all pins of a port.
+ * @param Port The port number (0 to 3).
+ * @return uint8_t Pin levels, bit n = pin n (0 for a bad port).
+ */
+uint8_t GpioPortRead(uint8_t Port);
+
+/**
+ * @brief Writes all pins of a port in one SFR write.
+ * @param Port The port number (0 to 3).
+ * @param Value Pin levels, bit n = pin n.
+ * @return EGpioStatus GPIO_OK on success, GPIO_ERR on invalid port.
+ */
+EGpioStatus GpioPortWrite(uint8_t Port, uint8_t Value);
+
+/**
+ * @brief Changes the masked pins of a port in one write, with interrupts off.
+ * @details The read-modify-write cannot be torn by an ISR that drives
+ *          other pins of the same port.
+ * @param Port The port number (0 to 3).
+ * @param Mask Pins to change; pins the port does not have are ignored.
+ * @param Value New levels of the masked pins.
+ * @return EGpioStatus GPIO_OK on success, GPIO_ERR on invalid port.
+ */
+EGpioStatus GpioPortMask(uint8_t Port, uint8_t Mask, uint8_t Value);
+
+#if GPIO_BENCH_ENABLE
+/**
+ * @brief Times pin writes through each path and writes the results to GPIO_BENCH_VP.
+ */
+void GpioBench(void);
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
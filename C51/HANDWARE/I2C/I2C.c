@@ -0,0 +1,321 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "I2C.h"
+#if I2C_BENCH_ENABLE
+#include "TimeStamp.h"
+#endif
+
+#if I2C_ENABLE
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+// Both lines are open-drain: writing 1 releases the line to the pull-up,
+// writing 0 drives it low. SCL is only low or released by the master and
+// every release waits for a stretching slave to let go.
+
+/**
+ * @def I2C_HALF
+ * @brief Half an SCL period of busy wait (I2C_DELAY loop passes).
+ */
+#if I2C_DELAY
+#define I2C_HALF() \
+{ \
+    uint8_t d_ = I2C_DELAY; \
+    do {} while (--d_); \
+}
+#else
+#define I2C_HALF()
+#endif
+
+/**
+ * @def I2C_SCL_RISE
+ * @brief Releases SCL and waits until it is high (clock stretching).
+ */
+#define I2C_SCL_RISE() \
+{ \
+    uint16_t t_ = I2C_STRETCH_MAX; \
+    GPIO_SET(I2C_SCL_PIN); \
+    while (!GPIO_READ(I2C_SCL_PIN)) \
+    { \
+        if (--t_ == 0) \
+        { \
+            I2cFault = 1; \
+            break; \
+        } \
+    } \
+}
+
+/**
+ * @def I2C_PUT_BIT
+ * @brief One bit out, SCL low on entry and exit.
+ */
+#define I2C_PUT_BIT(Out, Mask) \
+{ \
+    GPIO_WRITE(I2C_SDA_PIN, (Out) & (Mask)); \
+    I2C_HALF(); \
+    I2C_SCL_RISE(); \
+    I2C_HALF(); \
+    GPIO_CLR(I2C_SCL_PIN); \
+}
+
+/**
+ * @def I2C_GET_BIT
+ * @brief One bit in, SDA released, SCL low on entry and exit.
+ */
+#define I2C_GET_BIT(In, Mask) \
+{ \
+    I2C_HALF(); \
+    I2C_SCL_RISE(); \
+    if (GPIO_READ(I2C_SDA_PIN)) (In) |= (Mask); \
+    I2C_HALF(); \
+    GPIO_CLR(I2C_SCL_PIN); \
+}
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static bit I2cHeld;			///< START sent, no STOP yet: the next START is a repeated one.
+static bit I2cFault;			///< A slave stretched SCL beyond I2C_STRETCH_MAX.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Sends one byte and reads the acknowledge.
+ * @param Out Byte to send.
+ * @return bit 1 if the slave acknowledged.
+ */
+static bit I2cPutByte(uint8_t Out)
+{
+    bit ack;
+
+    I2C_PUT_BIT(Out, 0x80);
+    I2C_PUT_BIT(Out, 0x40);
+    I2C_PUT_BIT(Out, 0x20);
+    I2C_PUT_BIT(Out, 0x10);
+    I2C_PUT_BIT(Out, 0x08);
+    I2C_PUT_BIT(Out, 0x04);
+    I2C_PUT_BIT(Out, 0x02);
+    I2C_PUT_BIT(Out, 0x01);
+
+    GPIO_SET(I2C_SDA_PIN);
+    I2C_HALF();
+    I2C_SCL_RISE();
+    ack = !GPIO_READ(I2C_SDA_PIN);
+    I2C_HALF();
+    GPIO_CLR(I2C_SCL_PIN);
+    return ack;
+}
+
+/**
+ * @brief Receives one byte and sends the acknowledge.
+ * @param Ack 1 to acknowledge, 0 to NACK (last byte).
+ * @return uint8_t Byte received.
+ */
+static uint8_t I2cGetByte(bit Ack)
+{
+    uint8_t in = 0;
+
+    GPIO_SET(I2C_SDA_PIN);
+    I2C_GET_BIT(in, 0x80);
+    I2C_GET_BIT(in, 0x40);
+    I2C_GET_BIT(in, 0x20);
+    I2C_GET_BIT(in, 0x10);
+    I2C_GET_BIT(in, 0x08);
+    I2C_GET_BIT(in, 0x04);
+    I2C_GET_BIT(in, 0x02);
+    I2C_GET_BIT(in, 0x01);
+
+    GPIO_WRITE(I2C_SDA_PIN, !Ack);
+    I2C_HALF();
+    I2C_SCL_RISE();
+    I2C_HALF();
+    GPIO_CLR(I2C_SCL_PIN);
+    GPIO_SET(I2C_SDA_PIN);
+    return in;
+}
+
+/**
+ * @brief Configures I2C_SCL_PIN and I2C_SDA_PIN open-drain and frees a stuck bus.
+ * @return I2cStatus I2C_OK, or I2C_BUS_ERR if the bus stays low.
+ */
+I2cStatus I2cInit(void)
+{
+    uint8_t clk;
+
+    InitGpio(GPIO_IN, I2C_SCL_PIN, GPIO_HIGHT);
+    InitGpio(GPIO_IN, I2C_SDA_PIN, GPIO_HIGHT);
+    I2cFault = 0;
+    for (clk = 0; clk < 9 && !GPIO_READ(I2C_SDA_PIN); clk++)
+    {
+        GPIO_CLR(I2C_SCL_PIN);
+        I2C_HALF();
+        I2C_SCL_RISE();
+        I2C_HALF();
+    }
+    GPIO_CLR(I2C_SCL_PIN);
+    I2C_HALF();
+    I2cHeld = 1;
+    I2cStop();
+    if (I2cFault || !GPIO_READ(I2C_SDA_PIN) || !GPIO_READ(I2C_SCL_PIN)) return I2C_BUS_ERR;
+    return I2C_OK;
+}
+
+/**
+ * @brief Sends a START, or a repeated START if the bus is held, and the address byte.
+ * @param Addr 7-bit slave address.
+ * @param Read 1 to read from the slave, 0 to write.
+ * @return I2cStatus I2C_OK if the slave acknowledged.
+ */
+I2cStatus I2cStart(uint8_t Addr, bit Read)
+{
+    I2cFault = 0;
+    if (I2cHeld)
+    {
+        GPIO_SET(I2C_SDA_PIN);
+        I2C_HALF();
+        I2C_SCL_RISE();
+        I2C_HALF();
+    }
+    else if (!GPIO_READ(I2C_SDA_PIN) || !GPIO_READ(I2C_SCL_PIN))
+    {
+        return I2C_BUS_ERR;
+    }
+    GPIO_CLR(I2C_SDA_PIN);
+    I2C_HALF();
+    GPIO_CLR(I2C_SCL_PIN);
+    I2cHeld = 1;
+    if (!I2cPutByte((Addr << 1) | (Read ? 1 : 0))) return I2cFault ? I2C_TIMEOUT : I2C_NACK;
+    return I2cFault ? I2C_TIMEOUT : I2C_OK;
+}
+
+/**
+ * @brief Sends a block after I2cStart() with Read = 0.
+ * @param Buf Bytes to send.
+ * @param Len Number of bytes.
+ * @return I2cStatus I2C_OK, or the status of the first failing byte (the rest is not sent).
+ */
+I2cStatus I2cWrite(const uint8_t *Buf, uint16_t Len)
+{
+    while (Len--)
+    {
+        if (!I2cPutByte(*Buf++)) return I2cFault ? I2C_TIMEOUT : I2C_NACK;
+    }
+    return I2cFault ? I2C_TIMEOUT : I2C_OK;
+}
+
+/**
+ * @brief Receives a block after I2cStart() with Read = 1.
+ * @param Buf Receives the bytes.
+ * @param Len Number of bytes.
+ * @param Last 1 to NACK the final byte, required before I2cStop() or a repeated START.
+ * @return I2cStatus I2C_OK or I2C_TIMEOUT.
+ */
+I2cStatus I2cRead(uint8_t *Buf, uint16_t Len, bit Last)
+{
+    while (Len--)
+    {
+        *Buf++ = I2cGetByte(Len != 0 || !Last);
+    }
+    return I2cFault ? I2C_TIMEOUT : I2C_OK;
+}
+
+/**
+ * @brief Sends a STOP and releases the bus.
+ */
+void I2cStop(void)
+{
+    if (!I2cHeld) return;
+    GPIO_CLR(I2C_SDA_PIN);
+    I2C_HALF();
+    I2C_SCL_RISE();
+    I2C_HALF();
+    GPIO_SET(I2C_SDA_PIN);
+    I2C_HALF();
+    I2cHeld = 0;
+}
+
+/**
+ * @brief Writes a block, then reads one after a repeated START, in one transaction.
+ * @param Addr 7-bit slave address.
+ * @param Out Bytes to write.
+ * @param OutLen Number of bytes to write.
+ * @param In Receives the bytes read.
+ * @param InLen Number of bytes to read.
+ * @return I2cStatus I2C_OK on success.
+ */
+I2cStatus I2cWriteRead(uint8_t Addr, const uint8_t *Out, uint16_t OutLen, uint8_t *In, uint16_t InLen)
+{
+    I2cStatus st;
+
+    st = I2cStart(Addr, 0);
+    if (st == I2C_OK) st = I2cWrite(Out, OutLen);
+    if (st == I2C_OK && InLen)
+    {
+        st = I2cStart(Addr, 1);
+        if (st == I2C_OK) st = I2cRead(In, InLen, 1);
+    }
+    if (st != I2C_BUS_ERR) I2cStop();
+    return st;
+}
+
+#if I2C_BENCH_ENABLE
+/**
+ * @brief Measures the SCL rate and writes it to I2C_BENCH_VP.
+ */
+void I2cBench(void)
+{
+    static xdata uint8_t buf[32];
+    uint16_t result[3];
+    uint32_t ticks;
+
+    I2cFault = 0;
+    GPIO_CLR(I2C_SCL_PIN);
+    ticks = TimeNowTicks();
+    I2cRead(buf, sizeof(buf), 1);	//32 bytes of 9 clocks
+    ticks = TimeElapsedTicks(ticks);
+    GPIO_SET(I2C_SCL_PIN);
+    if (ticks == 0) ticks = 1;
+
+    result[0] = (uint16_t)((32UL * 9 * TIME_TICKS_PER_MS) / ticks);
+    result[1] = I2C_DELAY;
+    BenchReport(I2C_BENCH_VP, result, 2);
+}
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,126 @@
+#ifndef __I2C_H__
+#define __I2C_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "GPIO.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @brief Enum for I2C transfer status.
+ */
+typedef enum
+{
+    I2C_OK = 0,         ///< Transfer acknowledged.
+    I2C_NACK = 1,       ///< Address or data byte not acknowledged.
+    I2C_TIMEOUT = 2,    ///< SCL held low longer than I2C_STRETCH_MAX polls.
+    I2C_BUS_ERR = 3,    ///< SDA or SCL low on an idle bus.
+} I2cStatus;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if I2C_ENABLE
+/**
+ * @brief Configures I2C_SCL_PIN and I2C_SDA_PIN open-drain and frees a stuck bus.
+ * @details A slave left mid-byte by a reset can hold SDA low; up to nine
+ *          clocks and a STOP release it. External pull-ups are required.
+ * @return I2cStatus I2C_OK, or I2C_BUS_ERR if the bus stays low.
+ */
+I2cStatus I2cInit(void);
+
+/**
+ * @brief Sends a START, or a repeated START if the bus is held, and the address byte.
+ * @details The bus stays held whatever the result, end every transaction
+ *          with I2cStop(). Main loop only.
+ * @param Addr 7-bit slave address.
+ * @param Read 1 to read from the slave, 0 to write.
+ * @return I2cStatus I2C_OK if the slave acknowledged.
+ */
+I2cStatus I2cStart(uint8_t Addr, bit Read);
+
+/**
+ * @brief Sends a block after I2cStart() with Read = 0.
+ * @param Buf Bytes to send.
+ * @param Len Number of bytes.
+ * @return I2cStatus I2C_OK, or the status of the first failing byte (the rest is not sent).
+ */
+I2cStatus I2cWrite(const uint8_t *Buf, uint16_t Len);
+
+/**
+ * @brief Receives a block after I2cStart() with Read = 1.
+ * @param Buf Receives the bytes.
+ * @param Len Number of bytes.
+ * @param Last 1 to NACK the final byte, required before I2cStop() or a repeated START.
+ * @return I2cStatus I2C_OK or I2C_TIMEOUT.
+ */
+I2cStatus I2cRead(uint8_t *Buf, uint16_t Len, bit Last);
+
+/**
+ * @brief Sends a STOP and releases the bus.
+ */
+void I2cStop(void);
+
+/**
+ * @brief Writes a block, then reads one after a repeated START, in one transaction.
+ * @details The usual register or EEPROM read: Out holds the register or
+ *          memory address. With InLen = 0 it is a plain write.
+ * @param Addr 7-bit slave address.
+ * @param Out Bytes to write.
+ * @param OutLen Number of bytes to write.
+ * @param In Receives the bytes read.
+ * @param InLen Number of bytes to read.
+ * @return I2cStatus I2C_OK on success.
+ */
+I2cStatus I2cWriteRead(uint8_t Addr, const uint8_t *Out, uint16_t OutLen, uint8_t *In, uint16_t InLen);
+
+#if I2C_BENCH_ENABLE
+/**
+ * @brief Measures the SCL rate and writes it to I2C_BENCH_VP.
+ * @details Reads 32 bytes from the bus without addressing a slave, so
+ *          the pull-ups must be fitted. Results: [0] SCL rate in kHz with
+ *          I2C_DELAY, [1] I2C_DELAY, [2] TIME_TICKS_PER_MS. Adjust I2C_DELAY
+ *          until [0] is at or below the slowest device on the bus.
+ */
+void I2cBench(void);
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
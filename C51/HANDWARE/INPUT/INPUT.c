@@ -0,0 +1,192 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "INPUT.h"
+#include "GPIO.h"
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+/**
+ * @var uint8_t InputScanCnt
+ * @brief Milliseconds to the next scan.
+ */
+uint8_t data InputScanCnt = INPUT_SCAN_MS;
+
+#if INPUT_ENABLE
+static code uint8_t InputMask[4] = {INPUT_MASK_P0, INPUT_MASK_P1, INPUT_MASK_P2, INPUT_MASK_P3 & 0x0F};	///< Scanned pins.
+static code uint8_t InputLongMask[4] = {INPUT_LONG_MASK_P0, INPUT_LONG_MASK_P1, INPUT_LONG_MASK_P2, INPUT_LONG_MASK_P3 & 0x0F};	///< Pins with long-press events.
+
+static xdata uint8_t InputDeb[4];							///< Debounced levels.
+static xdata uint8_t InputCnt0[4];						///< Vertical counter, bit 0 of every pin.
+static xdata uint8_t InputCnt1[4];						///< Vertical counter, bit 1 of every pin.
+static xdata uint8_t InputLongDone[4];					///< Long press already reported.
+static xdata uint16_t InputHeld[4][8];					///< Scans held low, long-press pins only.
+static xdata uint8_t InputQueue[INPUT_QUEUE_DEPTH];		///< Event ring.
+static volatile uint8_t xdata InputHead = 0;				///< Next slot to write, ISR only.
+static volatile uint8_t xdata InputTail = 0;				///< Next slot to read, main loop only.
+static xdata uint8_t InputLostCnt = 0;					///< Events dropped on a full ring.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Appends an event; drops it when the ring is full.
+ * @param Ev Event byte.
+ */
+static void InputPush(uint8_t Ev)
+{
+    uint8_t next = (InputHead + 1) & (INPUT_QUEUE_DEPTH - 1);
+
+    if (next == InputTail)
+    {
+        if (InputLostCnt != 0xFF) InputLostCnt++;
+        return;
+    }
+    InputQueue[InputHead] = Ev;
+    InputHead = next;       //Publish only after the slot is written
+}
+
+/**
+ * @brief Configures the scanned pins as inputs and takes their levels as the debounced state.
+ */
+void InputInit(void)
+{
+    uint8_t port, pin;
+
+    for (port = 0; port < 4; port++)
+    {
+        for (pin = 0; pin < 8; pin++)
+        {
+            if (InputMask[port] & (1 << pin)) InitGpio(GPIO_IN, port, pin, GPIO_HIGHT);
+            InputHeld[port][pin] = 0;
+        }
+        InputDeb[port] = GpioPortRead(port) & InputMask[port];
+        InputCnt0[port] = 0;
+        InputCnt1[port] = 0;
+        InputLongDone[port] = 0;
+    }
+    InputHead = 0;
+    InputTail = 0;
+    InputLostCnt = 0;
+    InputScanCnt = INPUT_SCAN_MS;
+}
+
+/**
+ * @brief Samples and debounces all scanned pins. Called from Timer2Isr only.
+ */
+void InputScanIsr(void)
+{
+    uint8_t sample[4];
+    uint8_t port, pin, delta, toggle, held, bitm;
+
+    //All ports in one go, so pins of different ports are sampled together
+    sample[0] = P0;
+    sample[1] = P1;
+    sample[2] = P2;
+    sample[3] = P3;
+
+    for (port = 0; port < 4; port++)
+    {
+        //2-bit vertical counter per pin: counts scans that differ from the
+        //debounced level, resets on a matching scan, toggles at the fourth
+        delta = (sample[port] & InputMask[port]) ^ InputDeb[port];
+        InputCnt1[port] = (InputCnt1[port] ^ InputCnt0[port]) & delta;
+        InputCnt0[port] = ~InputCnt0[port] & delta;
+        toggle = delta & ~(InputCnt0[port] | InputCnt1[port]);
+        InputDeb[port] ^= toggle;
+
+        if (toggle)
+        {
+            for (pin = 0, bitm = 1; pin < 8; pin++, bitm <<= 1)
+            {
+                if (!(toggle & bitm)) continue;
+                InputPush(((InputDeb[port] & bitm) ? INPUT_EV_RISE : INPUT_EV_FALL) | (port << 3) | pin);
+                InputHeld[port][pin] = 0;
+            }
+            InputLongDone[port] &= ~toggle;
+        }
+
+        //Long press: only pins that are low, enabled and not yet reported cost anything
+        held = ~InputDeb[port] & InputLongMask[port] & ~InputLongDone[port];
+        if (held == 0) continue;
+        for (pin = 0, bitm = 1; pin < 8; pin++, bitm <<= 1)
+        {
+            if (!(held & bitm)) continue;
+            if (++InputHeld[port][pin] < INPUT_LONG_TICKS) continue;
+            InputPush(INPUT_EV_LONG | (port << 3) | pin);
+            InputLongDone[port] |= bitm;
+        }
+    }
+}
+
+/**
+ * @brief Takes the oldest event from the queue.
+ * @param Ev Receives the event byte.
+ * @return bit 1 if an event was taken, 0 if the queue is empty.
+ */
+bit InputGetEvent(uint8_t *Ev)
+{
+    uint8_t tail = InputTail;
+
+    if (tail == InputHead) return 0;
+    *Ev = InputQueue[tail];
+    InputTail = (tail + 1) & (INPUT_QUEUE_DEPTH - 1);
+    return 1;
+}
+
+/**
+ * @brief Returns the debounced levels of a port.
+ * @param Port The port number (0 to 3).
+ * @return uint8_t Levels of the scanned pins (others read 0).
+ */
+uint8_t InputState(uint8_t Port)
+{
+    if (Port > GPIO_PORT_3) return 0;
+    return InputDeb[Port];
+}
+
+/**
+ * @brief Returns the number of events lost to a full queue.
+ * @return uint8_t Lost events (saturates at 255).
+ */
+uint8_t InputLost(void)
+{
+    return InputLostCnt;
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
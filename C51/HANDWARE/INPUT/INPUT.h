@@ -0,0 +1,139 @@
+#ifndef __INPUT_H__
+#define __INPUT_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+// Event byte: TYPE(2) 0 PORT(2) PIN(3).
+#define INPUT_EV_RISE			0x40	///< Debounced low to high.
+#define INPUT_EV_FALL			0x80	///< Debounced high to low.
+#define INPUT_EV_LONG			0xC0	///< Held low for INPUT_LONG_MS (pins in INPUT_LONG_MASK_Px).
+
+/**
+ * @def INPUT_EV_TYPE
+ * @brief Event type of an event byte (INPUT_EV_RISE, _FALL or _LONG).
+ */
+#define INPUT_EV_TYPE(Ev)		((Ev) & 0xC0)
+
+/**
+ * @def INPUT_EV_PORT
+ * @brief Port of an event byte.
+ */
+#define INPUT_EV_PORT(Ev)		(((Ev) >> 3) & 0x03)
+
+/**
+ * @def INPUT_EV_PIN
+ * @brief Pin of an event byte.
+ */
+#define INPUT_EV_PIN(Ev)		((Ev) & 0x07)
+
+/**
+ * @def INPUT_LONG_TICKS
+ * @brief Scans a pin must stay low to report INPUT_EV_LONG.
+ */
+#define INPUT_LONG_TICKS		(INPUT_LONG_MS / INPUT_SCAN_MS)
+
+#if INPUT_ENABLE
+/**
+ * @def INPUT_SCAN_TICK_ISR
+ * @brief Scan divider, called from Timer2Isr every millisecond.
+ */
+#define INPUT_SCAN_TICK_ISR() \
+{ \
+    if (--InputScanCnt == 0) \
+    { \
+        InputScanCnt = INPUT_SCAN_MS; \
+        InputScanIsr(); \
+    } \
+}
+#else
+#define INPUT_SCAN_TICK_ISR()
+#endif
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Milliseconds to the next scan. */
+extern uint8_t data InputScanCnt;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if INPUT_ENABLE
+/**
+ * @brief Configures the scanned pins as inputs and takes their levels as the debounced state.
+ * @details Call before Timer2 starts. The pins are INPUT_MASK_P0..P3.
+ */
+void InputInit(void);
+
+/**
+ * @brief Samples and debounces all scanned pins. Called from Timer2Isr only.
+ * @details All four ports are read at once and every pin is debounced in
+ *          parallel by a 2-bit vertical counter: a pin changes state after
+ *          four equal scans that differ from it (4 * INPUT_SCAN_MS). Edges
+ *          and long presses are pushed to the event queue.
+ */
+void InputScanIsr(void);
+
+/**
+ * @brief Takes the oldest event from the queue.
+ * @details Single producer (the scan ISR), single consumer (the main loop):
+ *          each side only writes its own index, so no locking is needed.
+ * @param Ev Receives the event byte.
+ * @return bit 1 if an event was taken, 0 if the queue is empty.
+ */
+bit InputGetEvent(uint8_t *Ev);
+
+/**
+ * @brief Returns the debounced levels of a port.
+ * @param Port The port number (0 to 3).
+ * @return uint8_t Levels of the scanned pins (others read 0).
+ */
+uint8_t InputState(uint8_t Port);
+
+/**
+ * @brief Returns the number of events lost to a full queue.
+ * @return uint8_t Lost events (saturates at 255).
+ */
+uint8_t InputLost(void);
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,257 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "PID.h"
+#include "CALIB.h"
+#include "PWM.h"
+#include "SoftTimer.h"
+#include "TimeStamp.h"
+
+#if PID_ENABLE
+#if !ADC_SAMPLER_ENABLE
+#error "PID_ENABLE needs ADC_SAMPLER_ENABLE"
+#endif
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def PID_TERM_MAX
+ * @brief Limit of the P and D terms (Q8), keeps P + I + D inside int32_t.
+ */
+#define PID_TERM_MAX		0x20000000L
+
+/**
+ * @def PID_I_MAX
+ * @brief Limit of the integral (Q8): the full output range.
+ */
+#define PID_I_MAX			((int32_t)PWM_ACCURACY << 8)
+
+/**
+ * @brief State of one loop.
+ */
+typedef struct
+{
+    uint16_t Period;        ///< Control period in ms, 0 when stopped.
+    uint16_t Countdown;     ///< ms left to the next run.
+    uint8_t  Channel;       ///< AdcChannel.
+    uint8_t  Output;        ///< PidOutput.
+    uint8_t  Action;        ///< PidAction.
+    uint8_t  Primed;        ///< Last and Prev hold a run.
+    int16_t  Prev;          ///< Measurement of the previous run.
+    int32_t  Integral;      ///< Integral term, Q8.
+    uint32_t Last;          ///< TimeNowUs() of the previous run.
+    uint16_t JitterMax;     ///< Largest period deviation, us.
+} PidLoop;
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static xdata PidLoop PidLoops[PID_LOOPS];				///< Loop state.
+static xdata uint8_t PidTimer = SOFT_TIMER_NONE;		///< 1 ms tick, running while any loop is.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Limits a value to +-Max.
+ * @param v Value.
+ * @param Max Limit (> 0).
+ * @return int32_t Clamped value.
+ */
+static int32_t PidClamp(int32_t v, int32_t Max)
+{
+    if (v > Max) return Max;
+    if (v < -Max) return -Max;
+    return v;
+}
+
+/**
+ * @brief Runs one control step of a loop.
+ * @param Loop Loop index.
+ */
+static void PidRun(uint8_t Loop)
+{
+    PidLoop *l = &PidLoops[Loop];
+    uint16_t vp = PID_VP + (uint16_t)Loop * PID_VP_STRIDE;
+    uint16_t par[4];
+    uint16_t out[4];
+    int16_t pv;
+    int32_t e, p, d, u;
+    uint32_t now, dev;
+
+    //Period deviation first, before the DGUS traffic of this run
+    now = TimeNowUs();
+    dev = 0;
+    if (l->Primed)
+    {
+        dev = now - l->Last;
+        dev = (dev > (uint32_t)l->Period * 1000) ? dev - (uint32_t)l->Period * 1000 : (uint32_t)l->Period * 1000 - dev;
+        if (dev > 0xFFFF) dev = 0xFFFF;
+        if ((uint16_t)dev > l->JitterMax) l->JitterMax = (uint16_t)dev;
+    }
+    l->Last = now;
+
+    ReadDgusVp(vp, (uint8_t*)par, 4);
+    pv = CalConvert((AdcChannel)l->Channel, AdcGetFiltered((AdcChannel)l->Channel));
+    if (!l->Primed) l->Prev = pv;
+
+    e = (int32_t)(int16_t)par[0] - pv;
+    if (l->Action == PID_REVERSE) e = -e;
+
+    p = PidClamp((int32_t)(par[1] & 0x7FFF) * e, PID_TERM_MAX);
+    //Derivative on the measurement, with the sign of the error
+    d = (int32_t)l->Prev - pv;
+    if (l->Action == PID_REVERSE) d = -d;
+    d = PidClamp((int32_t)(par[3] & 0x7FFF) * d, PID_TERM_MAX);
+
+    //Anti-windup: integrate unless the output is already saturated in the direction of the error
+    u = p + l->Integral + d;
+    if (!((u >= PID_I_MAX && e > 0) || (u <= 0 && e < 0)))
+    {
+        //One step never exceeds the full range, so the sum stays inside int32_t
+        l->Integral += PidClamp((int32_t)(par[2] & 0x7FFF) * e, PID_I_MAX);
+        if (l->Integral > PID_I_MAX) l->Integral = PID_I_MAX;
+        if (l->Integral < 0) l->Integral = 0;
+        u = p + l->Integral + d;
+    }
+    u = (u + 0x80) >> 8;
+    if (u < 0) u = 0;
+    if (u > PWM_ACCURACY) u = PWM_ACCURACY;
+
+    if (l->Output == PID_OUT_DAC) DacSetRaw((uint16_t)u);
+    else PwmSetRaw((uint16_t)u);
+
+    l->Prev = pv;
+    l->Primed = 1;
+    out[0] = (uint16_t)u;
+    out[1] = (uint16_t)pv;
+    out[2] = l->JitterMax;
+    out[3] = (uint16_t)dev;
+    WriteDgusVp(vp + 4, (uint8_t*)out, 4);
+}
+
+/**
+ * @brief 1 ms tick: runs the loops whose period has elapsed.
+ */
+static void PidTick(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PID_LOOPS; i++)
+    {
+        if (PidLoops[i].Period == 0) continue;
+        if (--PidLoops[i].Countdown) continue;
+        PidLoops[i].Countdown = PidLoops[i].Period;
+        PidRun(i);
+    }
+}
+
+/**
+ * @brief Stops all loops.
+ */
+void PidInit(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PID_LOOPS; i++)
+    {
+        PidLoops[i].Period = 0;
+    }
+    if (PidTimer != SOFT_TIMER_NONE) SoftTimerStop(PidTimer);
+    PidTimer = SOFT_TIMER_NONE;
+}
+
+/**
+ * @brief Starts a loop.
+ * @param Loop Loop index (0 to PID_LOOPS - 1).
+ * @param Channel ADC channel of the measurement.
+ * @param Output PID_OUT_PWM or PID_OUT_DAC.
+ * @param Action PID_DIRECT or PID_REVERSE.
+ * @param PeriodMs Control period in ms (>= 1).
+ * @return StatusPid PID_OK, or PID_ERR on invalid arguments.
+ */
+StatusPid PidStart(uint8_t Loop, AdcChannel Channel, PidOutput Output, PidAction Action, uint16_t PeriodMs)
+{
+    PidLoop *l;
+
+    if (Loop >= PID_LOOPS || PeriodMs == 0) return PID_ERR;
+    if (Channel < ADC_CHANNEL_1 || Channel > ADC_CHANNEL_7) return PID_ERR;
+    l = &PidLoops[Loop];
+    l->Channel = Channel;
+    l->Output = Output;
+    l->Action = Action;
+    l->Primed = 0;
+    l->Integral = 0;
+    l->JitterMax = 0;
+    l->Countdown = PeriodMs;
+    l->Period = PeriodMs;
+    if (PidTimer == SOFT_TIMER_NONE) PidTimer = SoftTimerStart(PidTick, 1, 1);
+    return PID_OK;
+}
+
+/**
+ * @brief Stops a loop; its output keeps the last value.
+ * @param Loop Loop index.
+ */
+void PidStop(uint8_t Loop)
+{
+    uint8_t i;
+
+    if (Loop >= PID_LOOPS) return;
+    PidLoops[Loop].Period = 0;
+
+    for (i = 0; i < PID_LOOPS; i++)
+    {
+        if (PidLoops[i].Period) return;
+    }
+    if (PidTimer != SOFT_TIMER_NONE) SoftTimerStop(PidTimer);
+    PidTimer = SOFT_TIMER_NONE;
+}
+
+/**
+ * @brief Returns the largest period deviation of a loop.
+ * @param Loop Loop index.
+ * @return uint16_t Deviation in us since PidStart() (saturated), 0 if out of range.
+ */
+uint16_t PidJitterMax(uint8_t Loop)
+{
+    if (Loop >= PID_LOOPS) return 0;
+    return PidLoops[Loop].JitterMax;
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
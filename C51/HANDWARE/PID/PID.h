@@ -0,0 +1,129 @@
+#ifndef __PID_H__
+#define __PID_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "ADC.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def PID_VP_STRIDE
+ * @brief VP words per loop, loop n starts at PID_VP + n * PID_VP_STRIDE.
+ * @details Written by the host (read every period):
+ *          0 setpoint, engineering units of CalConvert()
+ *          1 Kp, 2 Ki, 3 Kd: gains per period in Q8 (256 = 1.0), 0 to 32767
+ *          Published by the loop:
+ *          4 output, PWM_ACCURACY counts
+ *          5 measurement, engineering units
+ *          6 largest period deviation since PidStart(), us (saturated)
+ *          7 last period deviation, us (saturated)
+ */
+#define PID_VP_STRIDE		8
+
+/**
+ * @brief Enum for the output of a loop.
+ */
+typedef enum
+{
+    PID_OUT_PWM = 0,    ///< PwmSetRaw().
+    PID_OUT_DAC = 1,    ///< DacSetRaw().
+} PidOutput;
+
+/**
+ * @brief Enum for the sense of a loop.
+ */
+typedef enum
+{
+    PID_DIRECT = 0,     ///< Output rises while the measurement is below the setpoint (heater).
+    PID_REVERSE = 1,    ///< Output rises while the measurement is above the setpoint (fan).
+} PidAction;
+
+/**
+ * @brief Enum for PID operation status.
+ */
+typedef enum
+{
+    PID_OK = 0x00,  ///< Operation successful.
+    PID_ERR = 0xFF, ///< Invalid loop, channel or period.
+} StatusPid;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Stops all loops.
+ */
+void PidInit(void);
+
+/**
+ * @brief Starts a loop.
+ * @details A 1 ms SoftTimer counts each loop down and runs it every
+ *          PeriodMs, independent of AppProcess. A run reads the gains and
+ *          setpoint in one VP burst, takes the filtered ADC reading through
+ *          CalConvert() and drives the output in PWM_ACCURACY counts. The
+ *          integral is clamped to the output range and frozen while the
+ *          output is saturated in the direction of the error (anti-windup);
+ *          the derivative acts on the measurement, so setpoint steps do not
+ *          kick the output. The channel must be running in the ADC sampler.
+ *          Output frames are rate-limited to PWM_OUT_INTERVAL_MS, so
+ *          PeriodMs should not be shorter.
+ * @param Loop Loop index (0 to PID_LOOPS - 1).
+ * @param Channel ADC channel of the measurement.
+ * @param Output PID_OUT_PWM or PID_OUT_DAC.
+ * @param Action PID_DIRECT or PID_REVERSE.
+ * @param PeriodMs Control period in ms (>= 1).
+ * @return StatusPid PID_OK, or PID_ERR on invalid arguments.
+ */
+StatusPid PidStart(uint8_t Loop, AdcChannel Channel, PidOutput Output, PidAction Action, uint16_t PeriodMs);
+
+/**
+ * @brief Stops a loop; its output keeps the last value.
+ * @param Loop Loop index.
+ */
+void PidStop(uint8_t Loop);
+
+/**
+ * @brief Returns the largest period deviation of a loop.
+ * @param Loop Loop index.
+ * @return uint16_t Deviation in us since PidStart() (saturated), 0 if out of range.
+ */
+uint16_t PidJitterMax(uint8_t Loop);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,329 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "PULSE.h"
+#include "SoftTimer.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def PULSE_CHZ_TICKS
+ * @brief 0.01 Hz times Timer2 ticks per second: f = edges * PULSE_CHZ_TICKS / ticks.
+ */
+#define PULSE_CHZ_TICKS		((uint32_t)TIME_TICKS_PER_MS * 100000UL)
+
+/**
+ * @def PULSE_TIMEOUT_TICKS
+ * @brief PULSE_TIMEOUT_MS in Timer2 ticks.
+ */
+#define PULSE_TIMEOUT_TICKS	((uint32_t)PULSE_TIMEOUT_MS * TIME_TICKS_PER_MS)
+
+/**
+ * @def PULSE_IP_INT0
+ * @brief INT0 high priority bit in IP0 (same position as EX0 in IEN0).
+ */
+#define PULSE_IP_INT0		0x01
+
+/**
+ * @def PULSE_IP_INT1
+ * @brief INT1 high priority bit in IP0 (same position as EX1 in IEN0).
+ */
+#define PULSE_IP_INT1		0x04
+
+#if PULSE_ENABLE
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+uint32_t xdata PulseCnt[PULSE_CHANNELS];		///< Edges counted per channel (wraps).
+uint32_t xdata PulseLast[PULSE_CHANNELS];		///< Timer2 tick stamp of the last edge.
+uint32_t xdata PulsePrev[PULSE_CHANNELS];		///< Timer2 tick stamp of the edge before.
+
+/**
+ * @brief Gate state of one channel, main loop only.
+ */
+typedef struct
+{
+    uint32_t Cnt;           ///< Count at the end of the previous gate.
+    uint32_t Last;          ///< Last edge stamp at the end of the previous gate.
+    uint32_t Freq;          ///< Frequency, 0.01 Hz.
+    uint32_t Period;        ///< Last period, us.
+} PulseGate;
+
+static xdata PulseGate PulseGates[PULSE_CHANNELS];		///< Published results.
+static xdata uint8_t PulseTimer = SOFT_TIMER_NONE;		///< Gate tick.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Copies the ISR state of a channel with its interrupt masked.
+ * @param Ch Channel.
+ * @param Cnt Receives the count.
+ * @param Last Receives the last edge stamp.
+ * @param Prev Receives the edge stamp before.
+ */
+static void PulseSnapshot(uint8_t Ch, uint32_t *Cnt, uint32_t *Last, uint32_t *Prev)
+{
+    bit ea = EA;
+
+    EA = 0;
+    *Cnt = PulseCnt[Ch];
+    *Last = PulseLast[Ch];
+    *Prev = PulsePrev[Ch];
+    EA = ea;
+}
+
+/**
+ * @brief Computes A * B / C with a 64-bit intermediate.
+ * @details Shift-and-subtract, run once per gate and channel; C > 0.
+ * @return uint32_t Quotient, saturated to 0xFFFFFFFF.
+ */
+static uint32_t PulseMulDiv(uint32_t A, uint32_t B, uint32_t C)
+{
+    uint32_t hi, lo, mid1, mid2, q, r;
+    uint8_t i;
+
+    //A * B = hi:lo from four 16 x 16 products
+    lo = (A & 0xFFFF) * (B & 0xFFFF);
+    mid1 = (A >> 16) * (B & 0xFFFF);
+    mid2 = (A & 0xFFFF) * (B >> 16);
+    hi = (A >> 16) * (B >> 16);
+    hi += (mid1 >> 16) + (mid2 >> 16);
+    mid1 <<= 16;
+    lo += mid1;
+    if (lo < mid1) hi++;
+    mid2 <<= 16;
+    lo += mid2;
+    if (lo < mid2) hi++;
+
+    if (hi >= C) return 0xFFFFFFFFUL;
+    r = hi;
+    q = 0;
+    for (i = 0; i < 32; i++)
+    {
+        uint8_t carry = (r & 0x80000000UL) ? 1 : 0;
+        r = (r << 1) | (lo >> 31);
+        lo <<= 1;
+        q <<= 1;
+        if (carry || r >= C)
+        {
+            r -= C;
+            q |= 1;
+        }
+    }
+    return q;
+}
+
+/**
+ * @brief Gate tick: updates frequency and period and publishes them.
+ */
+static void PulseGateTick(void)
+{
+    PulseGate *g;
+    uint32_t cnt, last, prev, now;
+    uint16_t vp[PULSE_VP_STRIDE];
+    uint8_t ch;
+
+    now = TimeNowTicks();
+    for (ch = 0; ch < PULSE_CHANNELS; ch++)
+    {
+        g = &PulseGates[ch];
+        PulseSnapshot(ch, &cnt, &last, &prev);
+        if (cnt != g->Cnt)
+        {
+            //Edges g->Cnt..cnt lie between the stamps g->Last and last
+            if (g->Cnt != 0 && last != g->Last) g->Freq = PulseMulDiv(cnt - g->Cnt, PULSE_CHZ_TICKS, last - g->Last);
+            if (cnt >= 2) g->Period = TimeTicksToUs(last - prev);
+            g->Cnt = cnt;
+            g->Last = last;
+        }
+        else if (now - last >= PULSE_TIMEOUT_TICKS)
+        {
+            g->Freq = 0;
+            g->Period = 0;
+        }
+        vp[0] = (uint16_t)(cnt >> 16);
+        vp[1] = (uint16_t)cnt;
+        vp[2] = (uint16_t)(g->Freq >> 16);
+        vp[3] = (uint16_t)g->Freq;
+        vp[4] = (uint16_t)(g->Period >> 16);
+        vp[5] = (uint16_t)g->Period;
+        WriteDgusVp(PULSE_VP + (uint16_t)ch * PULSE_VP_STRIDE, (uint8_t*)vp, PULSE_VP_STRIDE);
+    }
+}
+
+/**
+ * @brief Clears a channel.
+ * @param Ch Channel.
+ */
+static void PulseClear(uint8_t Ch)
+{
+    bit ea = EA;
+
+    EA = 0;
+    PulseCnt[Ch] = 0;
+    PulseLast[Ch] = 0;
+    PulsePrev[Ch] = 0;
+    EA = ea;
+    PulseGates[Ch].Cnt = 0;
+    PulseGates[Ch].Last = 0;
+    PulseGates[Ch].Freq = 0;
+    PulseGates[Ch].Period = 0;
+}
+
+/**
+ * @brief Clears both channels and starts the publishing gate.
+ */
+void PulseInit(void)
+{
+    EX0 = 0;
+    EX1 = 0;
+    PulseClear(0);
+    PulseClear(1);
+    if (PulseTimer == SOFT_TIMER_NONE) PulseTimer = SoftTimerStart(PulseGateTick, PULSE_GATE_MS, PULSE_GATE_MS);
+}
+
+/**
+ * @brief Clears a channel and enables its external interrupt.
+ * @param Ch 0 for INT0, 1 for INT1.
+ * @param Edge Trigger, sets IT0/IT1.
+ */
+void PulseStart(uint8_t Ch, PulseEdge Edge)
+{
+    if (Ch == 0)
+    {
+        EX0 = 0;
+        IT0 = (Edge == PULSE_EDGE_FALLING);
+        PulseClear(0);
+        IP0 |= PULSE_IP_INT0;
+        IE0 = 0;
+        EX0 = 1;
+    }
+    else if (Ch == 1)
+    {
+        EX1 = 0;
+        IT1 = (Edge == PULSE_EDGE_FALLING);
+        PulseClear(1);
+        IP0 |= PULSE_IP_INT1;
+        IE1 = 0;
+        EX1 = 1;
+    }
+}
+
+/**
+ * @brief Disables the external interrupt of a channel and drops it to low
+ *        priority; its count stays readable.
+ * @param Ch 0 for INT0, 1 for INT1.
+ */
+void PulseStop(uint8_t Ch)
+{
+    if (Ch == 0)
+    {
+        EX0 = 0;
+        IP0 &= (uint8_t)~PULSE_IP_INT0;
+    }
+    else if (Ch == 1)
+    {
+        EX1 = 0;
+        IP0 &= (uint8_t)~PULSE_IP_INT1;
+    }
+}
+
+/**
+ * @brief Reads the edge count of a channel atomically.
+ * @param Ch Channel.
+ * @return uint32_t Edges since PulseStart() (wraps), 0 if out of range.
+ */
+uint32_t PulseCount(uint8_t Ch)
+{
+    uint32_t cnt, last, prev;
+
+    if (Ch >= PULSE_CHANNELS) return 0;
+    PulseSnapshot(Ch, &cnt, &last, &prev);
+    return cnt;
+}
+
+/**
+ * @brief Returns the frequency measured over the last gate.
+ * @param Ch Channel.
+ * @return uint32_t Frequency in 0.01 Hz.
+ */
+uint32_t PulseFreq(uint8_t Ch)
+{
+    if (Ch >= PULSE_CHANNELS) return 0;
+    return PulseGates[Ch].Freq;
+}
+
+/**
+ * @brief Returns the time between the last two edges.
+ * @param Ch Channel.
+ * @return uint32_t Period in us, 0 before two edges or after PULSE_TIMEOUT_MS without one.
+ */
+uint32_t PulsePeriod(uint8_t Ch)
+{
+    if (Ch >= PULSE_CHANNELS) return 0;
+    return PulseGates[Ch].Period;
+}
+
+#if PULSE_BENCH_ENABLE
+/**
+ * @brief Measures the INT0 edge cost and writes it to PULSE_BENCH_VP.
+ */
+void PulseBench(void)
+{
+    uint16_t result[4];
+    uint32_t hz;
+    uint8_t run;
+
+    IT0 = 1;
+    IP0 |= PULSE_IP_INT0;
+    EX0 = 1;
+    BENCH_TIME(result[0], run, IE0 = 1);    //Software edge: the ISR runs before the next instruction
+    EX0 = 0;
+    IP0 &= (uint8_t)~PULSE_IP_INT0;
+    PulseClear(0);
+
+    if (result[0] == 0) result[0] = 1;
+    hz = ((uint32_t)TIME_TICKS_PER_MS * 1000UL) / result[0];
+    result[1] = (uint16_t)(hz >> 16);
+    result[2] = (uint16_t)hz;
+    BenchReport(PULSE_BENCH_VP, result, 3);
+}
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,176 @@
+#ifndef __PULSE_H__
+#define __PULSE_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "TimeStamp.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def PULSE_CHANNELS
+ * @brief Pulse inputs: 0 = INT0, 1 = INT1.
+ */
+#define PULSE_CHANNELS		2
+
+/**
+ * @def PULSE_VP_STRIDE
+ * @brief VP words per channel, channel n starts at PULSE_VP + n * PULSE_VP_STRIDE.
+ * @details 0-1 pulse count, 2-3 frequency in 0.01 Hz, 4-5 last period in us
+ *          (32-bit values, high word first), refreshed every PULSE_GATE_MS.
+ */
+#define PULSE_VP_STRIDE		6
+
+/**
+ * @brief Enum for the trigger of a pulse input (ITx).
+ */
+typedef enum
+{
+    PULSE_LEVEL_LOW = 0,    ///< IT = 0: interrupts while the pin is low (counts repeat, for wake-up use).
+    PULSE_EDGE_FALLING = 1, ///< IT = 1: one count per falling edge.
+} PulseEdge;
+
+#if PULSE_ENABLE
+/**
+ * @def PULSE_EDGE_ISR
+ * @brief Edge handler, the whole body of the INT0/INT1 ISR.
+ * @details Counts the edge and timestamps it against Timer2; the period is
+ *          the difference of the last two stamps. Everything else happens
+ *          in the main loop. PulseStart() gives INT0/INT1 high priority,
+ *          so an edge preempts the Timer2 and UART ISRs instead of waiting
+ *          behind them: IE0/IE1 latch only one pending edge, and a second
+ *          edge during a long low priority ISR would be lost. No ISR
+ *          clears EA for its whole body, so an edge waits only for the
+ *          other edge handler and for the short EA-off sections (the
+ *          Timer2Isr time base update, the atomic sections of the main
+ *          loop); the input period must exceed the PulseBench() cost of
+ *          both channels together plus the longest of those sections.
+ * @param Ch Channel (constant).
+ */
+#define PULSE_EDGE_ISR(Ch) \
+{ \
+    uint32_t t_; \
+    TIME_NOW_TICKS_ISR(t_); \
+    PulsePrev[Ch] = PulseLast[Ch]; \
+    PulseLast[Ch] = t_; \
+    PulseCnt[Ch]++; \
+}
+#else
+#define PULSE_EDGE_ISR(Ch)
+#endif
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Edges counted per channel (wraps). */
+extern uint32_t xdata PulseCnt[PULSE_CHANNELS];
+
+/** @brief Timer2 tick stamp of the last edge. */
+extern uint32_t xdata PulseLast[PULSE_CHANNELS];
+
+/** @brief Timer2 tick stamp of the edge before. */
+extern uint32_t xdata PulsePrev[PULSE_CHANNELS];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if PULSE_ENABLE
+/**
+ * @brief Clears both channels and starts the publishing gate.
+ */
+void PulseInit(void);
+
+/**
+ * @brief Clears a channel and enables its external interrupt at high priority.
+ * @param Ch 0 for INT0, 1 for INT1.
+ * @param Edge Trigger, sets IT0/IT1.
+ */
+void PulseStart(uint8_t Ch, PulseEdge Edge);
+
+/**
+ * @brief Disables the external interrupt of a channel and drops it to low
+ *        priority; its count stays readable.
+ * @param Ch 0 for INT0, 1 for INT1.
+ */
+void PulseStop(uint8_t Ch);
+
+/**
+ * @brief Reads the edge count of a channel atomically.
+ * @param Ch Channel.
+ * @return uint32_t Edges since PulseStart() (wraps), 0 if out of range.
+ */
+uint32_t PulseCount(uint8_t Ch);
+
+/**
+ * @brief Returns the frequency measured over the last gate.
+ * @details Reciprocal measurement: edges counted between the last edge of
+ *          the previous gate and the last edge of this one, divided by the
+ *          Timer2 time between those two edges, so the resolution does not
+ *          depend on the gate length. With no edge in a gate the value is
+ *          held until PULSE_TIMEOUT_MS has passed since the last edge.
+ * @param Ch Channel.
+ * @return uint32_t Frequency in 0.01 Hz.
+ */
+uint32_t PulseFreq(uint8_t Ch);
+
+/**
+ * @brief Returns the time between the last two edges.
+ * @param Ch Channel.
+ * @return uint32_t Period in us, 0 before two edges or after PULSE_TIMEOUT_MS without one.
+ */
+uint32_t PulsePeriod(uint8_t Ch);
+
+#if PULSE_BENCH_ENABLE
+/**
+ * @brief Measures the INT0 edge cost and writes it to PULSE_BENCH_VP.
+ * @details Raises IE0 from software in a BENCH_TIME() loop. Results:
+ *          [0] ticks per edge (ISR entry, handler, exit and the loop),
+ *          [1-2] resulting upper bound of the input frequency in Hz (high
+ *          word first), [3] TIME_TICKS_PER_MS. With the edge ISRs
+ *          at high priority the low priority ISRs do not add to this bound,
+ *          but the longest EA-off section does (see PULSE_EDGE_ISR);
+ *          with both channels active it halves, and the main loop gets
+ *          only what the edges leave. Channel 0 is cleared afterwards; run
+ *          it before PulseStart().
+ */
+void PulseBench(void);
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -34,7 +34,11 @@ SOFTWARE.
 //==============================================================================
 #include "PWM.h" // OK
 #include "UART.h"
-#include "Delay.h"
+#include "SoftTimer.h"
+#include "TRACE.h"
+#if PWM_BENCH_ENABLE
+#include "TimeStamp.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
@@ -63,57 +67,307 @@ SOFTWARE.
  */
 #define MILI_VOLTAGE_MAX		13200
 
+/**
+ * @def DUTY_MAX_001
+ * @brief Maximum duty cycle in 0.01 % steps (100.00 %).
+ */
+#define DUTY_MAX_001			10000
+
+#if PWM_ACCURACY > DUTY_MAX_001
+#error "PWM_ACCURACY above 10000 needs a wider duty scale"
+#endif
+
+/**
+ * @def PWM_DUTY_SCALE
+ * @brief PWM_ACCURACY counts per 0.01 % in Q16, rounded.
+ * @details Kept 32-bit: at PWM_ACCURACY == DUTY_MAX_001 it is 65536.
+ */
+#define PWM_DUTY_SCALE			(((uint32_t)PWM_ACCURACY * 65536UL + DUTY_MAX_001 / 2) / DUTY_MAX_001)
+
+/**
+ * @def DAC_MV_SCALE
+ * @brief PWM_ACCURACY counts per mV in Q16, rounded.
+ */
+#define DAC_MV_SCALE			(((uint32_t)PWM_ACCURACY * 65536UL + MILI_VOLTAGE_MAX / 2) / MILI_VOLTAGE_MAX)
+
+/**
+ * @def PWM_SCALE
+ * @brief Applies a Q16 scale with rounding and clamps to PWM_ACCURACY.
+ * @details One 32-bit multiply (?C?LMUL in the C51 library) and a shift.
+ */
+#define PWM_SCALE(v, k)			PwmClamp((uint16_t)(((uint32_t)(v) * (k) + 0x8000UL) >> 16))
+
 //==============================================================================
 //---------------------------------VARIABLES------------------------------------
 //==============================================================================
 /**
  * @var uint16_t SetDataPwm0
- * @brief Stores PWM0 setting data.
+ * @brief Requested PWM0 setting, in PWM_ACCURACY counts.
  */
-uint16_t SetDataPwm0;
+xdata uint16_t SetDataPwm0 = 0;
 
 /**
  * @var uint16_t SetDataPwm1
- * @brief Stores PWM1 (DAC) setting data.
+ * @brief Requested PWM1 (DAC) setting, in PWM_ACCURACY counts.
  */
-uint16_t SetDataPwm1;
+xdata uint16_t SetDataPwm1 = 0;
 
 /**
  * @var uint8_t TempSet[6]
- * @brief Buffer for UART transmission of PWM/DAC settings.
+ * @brief Last frame sent to the UART3 co-processor: 0xAA, PWM0, PWM1, sum.
  */
-uint8_t TempSet[6] = {0xAA, 0x0A, 0x3A, 0x56, 0x78, 0x00};
+xdata uint8_t TempSet[6] = {0xAA, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+/**
+ * @brief Init progress of PWM0 and the DAC.
+ */
+typedef struct
+{
+    uint8_t  State;         ///< PwmInitState.
+    uint16_t Since;         ///< SoftTimerNow() when the command was written (mod 2^16).
+} PwmInitUnit;
+
+static xdata PwmInitUnit PwmInitUnits[2] = {{PWM_INIT_IDLE, 0}, {PWM_INIT_IDLE, 0}};	///< PWM0, DAC.
+static xdata uint8_t PwmInitTimer = SOFT_TIMER_NONE;	///< Acknowledge poll, running while a unit is busy.
+/**
+ * @brief Soft-start ramp of PWM0 or the DAC.
+ */
+typedef struct
+{
+    uint16_t Steps;         ///< Steps left, 0 when idle.
+    uint16_t Target;        ///< Final setting, counts.
+    uint32_t Pos;           ///< Current setting, counts in Q16.
+    int32_t  Step;          ///< Change per step, counts in Q16.
+} PwmRamp;
+
+static xdata PwmRamp PwmRamps[2];						///< PWM0, DAC.
+static xdata uint8_t PwmRampTimer = SOFT_TIMER_NONE;	///< Ramp step, every PWM_OUT_INTERVAL_MS while a ramp runs.
+static xdata uint8_t PwmOutValid = 0;					///< TempSet has been sent at least once.
+static xdata uint8_t PwmOutTimer = SOFT_TIMER_NONE;	///< Hold-off after a frame, running for PWM_OUT_INTERVAL_MS.
+static xdata uint16_t PwmOutSent = 0;				///< Frames sent (wraps).
 
 //==============================================================================
 //----------------------------------INIT---------------------------------------
 //==============================================================================
 /**
- * @brief Initializes PWM0 with specified divider and precision.
+ * @brief Polls the busy units for the DGUS acknowledge or the timeout.
+ */
+static void PwmInitPoll(void)
+{
+    uint16_t now = (uint16_t)SoftTimerNow();
+    uint8_t busy = 0;
+    uint8_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        if (PwmInitUnits[i].State != PWM_INIT_BUSY) continue;
+        if (!(ReadDgus(i ? PWM1_SET_ADDR : PWM0_SET_ADDR) & 0xFF00)) PwmInitUnits[i].State = PWM_INIT_OK;
+        else if ((uint16_t)(now - PwmInitUnits[i].Since) >= PWM_INIT_TIMEOUT_MS) PwmInitUnits[i].State = PWM_INIT_TIMEOUT;
+        else
+        {
+            busy = 1;
+            continue;
+        }
+        TraceEvent(TRACE_EV_INIT, ((uint16_t)(TRACE_INIT_PWM0 + i) << 8) | PwmInitUnits[i].State);
+    }
+    if (!busy)
+    {
+        SoftTimerStop(PwmInitTimer);
+        PwmInitTimer = SOFT_TIMER_NONE;
+    }
+}
+
+/**
+ * @brief Writes the settings of a unit and starts polling for the acknowledge.
+ * @param Unit 0 for PWM0, 1 for the DAC.
+ * @param Addr DGUS register of the unit.
+ * @param Div Clock divider.
+ * @param Precision Resolution value.
+ */
+static void PwmInitStart(uint8_t Unit, uint16_t Addr, uint8_t Div, uint16_t Precision)
+{
+    WriteDgus((Addr + 1), Precision);
+    WriteDgus(Addr, (0x5A00 + Div));
+    PwmInitUnits[Unit].Since = (uint16_t)SoftTimerNow();
+    PwmInitUnits[Unit].State = PWM_INIT_BUSY;
+    if (PwmInitTimer == SOFT_TIMER_NONE) PwmInitTimer = SoftTimerStart(PwmInitPoll, PWM_INIT_POLL_MS, PWM_INIT_POLL_MS);
+}
+
+/**
+ * @brief Starts initializing PWM0 with specified divider and precision.
  * @param Div Clock divider for PWM0 frequency.
  * @param Precision PWM0 resolution value.
  */
 void PwmInit(uint8_t Div, uint16_t Precision)
 {
-    WriteDgus((PWM0_SET_ADDR + 1), Precision);
-    WriteDgus(PWM0_SET_ADDR, (0x5A00 + Div));
-    while (ReadDgus(PWM0_SET_ADDR) & 0xFF00) { SysDelayUs(500); }
+    PwmInitStart(0, PWM0_SET_ADDR, Div, Precision);
 }
 
 /**
- * @brief Initializes DAC (PWM1) with specified divider and precision.
+ * @brief Starts initializing DAC (PWM1) with specified divider and precision.
  * @param Div Clock divider for DAC frequency.
  * @param Precision DAC resolution value.
  */
 void DacInit(uint8_t Div, uint16_t Precision)
 {
-    WriteDgus((PWM1_SET_ADDR + 1), Precision);
-    WriteDgus(PWM1_SET_ADDR, (0x5A00 + Div));
-    while (ReadDgus(PWM1_SET_ADDR) & 0xFF00) { SysDelayUs(500); }
+    PwmInitStart(1, PWM1_SET_ADDR, Div, Precision);
+}
+
+/**
+ * @brief Returns the init progress of PWM0.
+ * @return PwmInitState Current state.
+ */
+PwmInitState PwmInitStatus(void)
+{
+    return (PwmInitState)PwmInitUnits[0].State;
+}
+
+/**
+ * @brief Returns the init progress of the DAC.
+ * @return PwmInitState Current state.
+ */
+PwmInitState DacInitStatus(void)
+{
+    return (PwmInitState)PwmInitUnits[1].State;
 }
 
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
+/**
+ * @brief Checks whether the requested settings differ from the last frame sent.
+ * @return bit 1 if a frame is due.
+ */
+static bit PwmOutDirty(void)
+{
+    if (!PwmOutValid) return 1;
+    if ((((uint16_t)TempSet[1] << 8) | TempSet[2]) != SetDataPwm0) return 1;
+    return ((((uint16_t)TempSet[3] << 8) | TempSet[4]) != SetDataPwm1);
+}
+
+static void PwmOutHoldOff(void);
+
+/**
+ * @brief Sends both requested settings in one frame unless a hold-off is running.
+ */
+static void PwmOutUpdate(void)
+{
+    uint8_t cnt;
+
+    if (PwmOutTimer != SOFT_TIMER_NONE || !PwmOutDirty()) return;
+    TempSet[1] = SetDataPwm0 >> 8;
+    TempSet[2] = (uint8_t)SetDataPwm0;
+    TempSet[3] = SetDataPwm1 >> 8;
+    TempSet[4] = (uint8_t)SetDataPwm1;
+    TempSet[5] = 0;
+    for (cnt = 0; cnt < 5; cnt++) TempSet[5] += TempSet[cnt];
+    UartSendStr(3, TempSet, 6);
+    PwmOutValid = 1;
+    PwmOutSent++;
+    PwmOutTimer = SoftTimerStart(PwmOutHoldOff, PWM_OUT_INTERVAL_MS, 0);
+}
+
+/**
+ * @brief End of the hold-off: sends what was requested in the meantime.
+ */
+static void PwmOutHoldOff(void)
+{
+    PwmOutTimer = SOFT_TIMER_NONE;
+    PwmOutUpdate();
+}
+
+/**
+ * @brief Returns the number of PWM/DAC frames sent to UART3.
+ * @return uint16_t Frame count (wraps).
+ */
+uint16_t PwmOutFrames(void)
+{
+    return PwmOutSent;
+}
+
+//==============================================================================
+//----------------------------------SCALING-------------------------------------
+//==============================================================================
+/**
+ * @brief Limits a setting to PWM_ACCURACY.
+ * @param Counts Setting.
+ * @return uint16_t Clamped setting.
+ */
+static uint16_t PwmClamp(uint16_t Counts)
+{
+    return (Counts > PWM_ACCURACY) ? PWM_ACCURACY : Counts;
+}
+
+/**
+ * @brief Sets the requested counts of a unit.
+ * @param Unit 0 for PWM0, 1 for the DAC.
+ * @param Counts Setting, already clamped.
+ */
+static void PwmOutSet(uint8_t Unit, uint16_t Counts)
+{
+    if (Unit) SetDataPwm1 = Counts;
+    else SetDataPwm0 = Counts;
+    PwmOutUpdate();
+}
+
+//==============================================================================
+//-----------------------------------RAMP---------------------------------------
+//==============================================================================
+/**
+ * @brief Ramp step: moves every running ramp one step towards its target.
+ */
+static void PwmRampTick(void)
+{
+    PwmRamp *r;
+    uint8_t busy = 0;
+    uint8_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        r = &PwmRamps[i];
+        if (r->Steps == 0) continue;
+        if (--r->Steps == 0)
+        {
+            PwmOutSet(i, r->Target);
+            continue;
+        }
+        r->Pos += r->Step;
+        PwmOutSet(i, (uint16_t)(r->Pos >> 16));
+        busy = 1;
+    }
+    if (!busy)
+    {
+        SoftTimerStop(PwmRampTimer);
+        PwmRampTimer = SOFT_TIMER_NONE;
+    }
+}
+
+/**
+ * @brief Starts a ramp of a unit from its current setting.
+ * @param Unit 0 for PWM0, 1 for the DAC.
+ * @param Counts Target setting.
+ * @param TimeMs Ramp time.
+ */
+static void PwmRampStart(uint8_t Unit, uint16_t Counts, uint16_t TimeMs)
+{
+    PwmRamp *r = &PwmRamps[Unit];
+    uint16_t from = Unit ? SetDataPwm1 : SetDataPwm0;
+    uint16_t steps = TimeMs / PWM_OUT_INTERVAL_MS;
+
+    Counts = PwmClamp(Counts);
+    if (steps == 0 || Counts == from)
+    {
+        r->Steps = 0;
+        PwmOutSet(Unit, Counts);
+        return;
+    }
+    //The one division of a ramp; the steps only add
+    r->Step = ((int32_t)Counts - from) * 65536L / steps;
+    r->Pos = ((uint32_t)from << 16) + 0x8000;
+    r->Target = Counts;
+    r->Steps = steps;
+    if (PwmRampTimer == SOFT_TIMER_NONE) PwmRampTimer = SoftTimerStart(PwmRampTick, PWM_OUT_INTERVAL_MS, PWM_OUT_INTERVAL_MS);
+}
 
 //==============================================================================
 //-----------------------------------PWM----------------------------------------
@@ -124,18 +378,38 @@ void DacInit(uint8_t Div, uint16_t Precision)
  */
 void PwmSetDuty(uint16_t duty)
 {
-    uint8_t cnt = 0;
-    uint16_t TempDuty = 0;
-
     if (duty > DUTY_MAX) duty = DUTY_MAX;
-    if (duty == DUTY_MAX) { TempDuty = PWM_ACCURACY; }
-    else { TempDuty = ((uint32_t)PWM_ACCURACY * (uint32_t)duty) / DUTY_MAX; }
-    TempSet[0] = 0xAA;
-    TempSet[1] = TempDuty >> 8;
-    TempSet[2] = (uint8_t)TempDuty;
-    TempSet[5] = 0;
-    for (cnt = 0; cnt < 5; cnt++) TempSet[5] += TempSet[cnt];
-    for (cnt = 0; cnt < 6; cnt++) UartSendByte(3, TempSet[cnt]);
+    PwmSetDuty001(duty * (DUTY_MAX_001 / DUTY_MAX));
+}
+
+/**
+ * @brief Sets the duty cycle for PWM0 in 0.01 % steps.
+ * @param Duty001 Duty cycle, 0 to 10000 (100.00 %).
+ */
+void PwmSetDuty001(uint16_t Duty001)
+{
+    PwmRamps[0].Steps = 0;
+    PwmOutSet(0, PWM_SCALE(Duty001, PWM_DUTY_SCALE));
+}
+
+/**
+ * @brief Sets PWM0 in PWM_ACCURACY counts (full resolution).
+ * @param Counts 0 to PWM_ACCURACY.
+ */
+void PwmSetRaw(uint16_t Counts)
+{
+    PwmRamps[0].Steps = 0;
+    PwmOutSet(0, PwmClamp(Counts));
+}
+
+/**
+ * @brief Ramps PWM0 linearly from its current setting.
+ * @param Counts Target in PWM_ACCURACY counts.
+ * @param TimeMs Ramp time (0 sets the target at once).
+ */
+void PwmRampTo(uint16_t Counts, uint16_t TimeMs)
+{
+    PwmRampStart(0, Counts, TimeMs);
 }
 
 //==============================================================================
@@ -147,19 +421,52 @@ void PwmSetDuty(uint16_t duty)
  */
 void DacSetOut(uint16_t mV)
 {
-    uint8_t cnt = 0;
-    uint16_t TempVoltage = 0;
     if (mV > MILI_VOLTAGE_MAX) { mV = MILI_VOLTAGE_MAX; }
-    if (mV == MILI_VOLTAGE_MAX) { TempVoltage = PWM_ACCURACY; }
-    else { TempVoltage = ((uint32_t)PWM_ACCURACY * (uint32_t)mV) / MILI_VOLTAGE_MAX; }
-    TempSet[0] = 0xAA;
-    TempSet[3] = TempVoltage >> 8;
-    TempSet[4] = (uint8_t)TempVoltage;
-    TempSet[5] = 0;
-    for (cnt = 0; cnt < 5; cnt++) TempSet[5] += TempSet[cnt];
-    for (cnt = 0; cnt < 6; cnt++) { UartSendByte(3, TempSet[cnt]); }
+    PwmRamps[1].Steps = 0;
+    PwmOutSet(1, PWM_SCALE(mV, DAC_MV_SCALE));
+}
+
+/**
+ * @brief Sets the DAC (PWM1) in PWM_ACCURACY counts (full resolution).
+ * @param Counts 0 to PWM_ACCURACY.
+ */
+void DacSetRaw(uint16_t Counts)
+{
+    PwmRamps[1].Steps = 0;
+    PwmOutSet(1, PwmClamp(Counts));
+}
+
+/**
+ * @brief Ramps the DAC linearly from its current setting.
+ * @param Counts Target in PWM_ACCURACY counts.
+ * @param TimeMs Ramp time (0 sets the target at once).
+ */
+void DacRampTo(uint16_t Counts, uint16_t TimeMs)
+{
+    PwmRampStart(1, Counts, TimeMs);
 }
 
+#if PWM_BENCH_ENABLE
+//==============================================================================
+//----------------------------------BENCH---------------------------------------
+//==============================================================================
+/**
+ * @brief Times the mV to counts conversion: previous 32-bit division vs Q16 scale.
+ * @details Results (ticks per conversion, averaged by BENCH_TIME()) go to
+ *          PWM_BENCH_VP: [0] division, [1] Q16 scale, [2] TIME_TICKS_PER_MS.
+ *          Only the conversion is timed, not the frame queue.
+ */
+void PwmBench(void)
+{
+    volatile uint16_t sink;
+    uint16_t result[3];
+    uint8_t run;
+
+    BENCH_TIME(result[0], run, sink = ((uint32_t)PWM_ACCURACY * (uint32_t)(run * 200U)) / MILI_VOLTAGE_MAX);
+    BENCH_TIME(result[1], run, sink = PWM_SCALE(run * 200U, DAC_MV_SCALE));
+    BenchReport(PWM_BENCH_VP, result, 2);
+}
+#endif
 
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
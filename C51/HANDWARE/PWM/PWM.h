@@ -45,36 +45,123 @@ SOFTWARE.
  */
 #define PWM_FREQ_32KHZ		255
 
+/**
+ * @brief Enum for the init progress of PWM0 and the DAC.
+ */
+typedef enum
+{
+    PWM_INIT_IDLE = 0,      ///< Init not started.
+    PWM_INIT_BUSY = 1,      ///< Settings written, waiting for the DGUS acknowledge.
+    PWM_INIT_OK = 2,        ///< Acknowledged.
+    PWM_INIT_TIMEOUT = 3,   ///< No acknowledge within PWM_INIT_TIMEOUT_MS.
+} PwmInitState;
+
 
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
 /**
- * @brief Initializes PWM0 with specified divider and precision.
+ * @brief Starts initializing PWM0 with specified divider and precision.
+ * @details Returns at once. The DGUS acknowledge is polled every
+ *          PWM_INIT_POLL_MS from a SoftTimer, so PWM0, the DAC and other
+ *          start-up work proceed in parallel; PwmInitStatus() reports the
+ *          result and a TRACE_EV_INIT event is recorded.
  * @param Div Clock divider for PWM0 frequency.
  * @param Precision PWM0 resolution value.
  */
 void PwmInit(uint8_t Div, uint16_t Precision);
 
+/**
+ * @brief Returns the init progress of PWM0.
+ * @return PwmInitState Current state.
+ */
+PwmInitState PwmInitStatus(void);
+
 /**
  * @brief Sets the duty cycle for PWM0.
+ * @details Only records the request. A frame carrying both PWM0 and the DAC
+ *          goes to UART3 when a setting has changed, at most once per
+ *          PWM_OUT_INTERVAL_MS; changes during that time are coalesced into
+ *          the next frame. Needs the SoftTimer wheel running.
  * @param duty Duty cycle percentage (0 to 100).
  */
 void PwmSetDuty(uint16_t duty);
 
 /**
- * @brief Initializes DAC (PWM1) with specified divider and precision.
+ * @brief Sets the duty cycle for PWM0 in 0.01 % steps.
+ * @details Scaled by a Q16 factor fixed at compile time, one 32-bit
+ *          multiply and no division; queued like PwmSetDuty(). Cancels a
+ *          PWM0 ramp.
+ * @param Duty001 Duty cycle, 0 to 10000 (100.00 %).
+ */
+void PwmSetDuty001(uint16_t Duty001);
+
+/**
+ * @brief Sets PWM0 in PWM_ACCURACY counts (full resolution).
+ * @details Queued like PwmSetDuty(). Cancels a PWM0 ramp.
+ * @param Counts 0 to PWM_ACCURACY.
+ */
+void PwmSetRaw(uint16_t Counts);
+
+/**
+ * @brief Ramps PWM0 linearly from its current setting (soft start).
+ * @details One step per PWM_OUT_INTERVAL_MS, i.e. one per output frame;
+ *          any other PWM0 setter cancels the ramp.
+ * @param Counts Target in PWM_ACCURACY counts.
+ * @param TimeMs Ramp time (0 sets the target at once).
+ */
+void PwmRampTo(uint16_t Counts, uint16_t TimeMs);
+
+/**
+ * @brief Starts initializing DAC (PWM1) with specified divider and precision.
+ * @details Returns at once, see PwmInit(); DacInitStatus() reports the result.
  * @param Div Clock divider for DAC frequency.
  * @param Precision DAC resolution value.
  */
 void DacInit(uint8_t Div, uint16_t Precision);
 
+/**
+ * @brief Returns the init progress of the DAC.
+ * @return PwmInitState Current state.
+ */
+PwmInitState DacInitStatus(void);
+
 /**
  * @brief Sets the output voltage for DAC (in millivolts).
+ * @details Sent to UART3 together with PWM0, see PwmSetDuty(). Scaled by
+ *          a Q16 factor fixed at compile time instead of a 32-bit division.
+ *          Cancels a DAC ramp.
  * @param mV Output voltage in millivolts (0 to 10000).
  */
 void DacSetOut(uint16_t mV);
 
+/**
+ * @brief Sets the DAC (PWM1) in PWM_ACCURACY counts (full resolution).
+ * @details Queued like PwmSetDuty(). Cancels a DAC ramp.
+ * @param Counts 0 to PWM_ACCURACY.
+ */
+void DacSetRaw(uint16_t Counts);
+
+/**
+ * @brief Ramps the DAC linearly from its current setting, see PwmRampTo().
+ * @param Counts Target in PWM_ACCURACY counts.
+ * @param TimeMs Ramp time (0 sets the target at once).
+ */
+void DacRampTo(uint16_t Counts, uint16_t TimeMs);
+
+/**
+ * @brief Returns the number of PWM/DAC frames sent to UART3.
+ * @return uint16_t Frame count (wraps).
+ */
+uint16_t PwmOutFrames(void);
+
+#if PWM_BENCH_ENABLE
+/**
+ * @brief Times the mV to counts conversion and writes the results to PWM_BENCH_VP.
+ */
+void PwmBench(void);
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
@@ -0,0 +1,192 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SCHEDULER.h"
+#include "TRACE.h"
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/**
+ * @var uint8_t SchedReady
+ * @brief Ready bitmap per priority level, bit n = task index n.
+ * @details Kept in DATA so a signal with a constant ID is a single ORL.
+ */
+uint8_t data SchedReady[SCHED_LEVELS];
+
+/**
+ * @var uint8_t SchedCurrent
+ * @brief Task running now, read by the watchdog supervisor on a stall.
+ */
+uint8_t data SchedCurrent = SCHED_TASK_NONE;
+
+/**
+ * @var uint32_t SchedReadyAt
+ * @brief Tick timestamp at which each task became ready.
+ */
+uint32_t xdata SchedReadyAt[SCHED_TASK_MAX];
+
+/**
+ * @var SchedTask SchedTasks
+ * @brief Task table, indexed by task ID.
+ */
+static SchedTask xdata SchedTasks[SCHED_TASK_MAX];
+
+/**
+ * @var SchedStats SchedTaskStats
+ * @brief Statistics per task.
+ */
+static SchedStats xdata SchedTaskStats[SCHED_TASK_MAX];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears the task table, ready bitmaps and statistics.
+ */
+void SchedInit(void)
+{
+    uint8_t i;
+
+    EA = 0;
+    for (i = 0; i < SCHED_LEVELS; i++) SchedReady[i] = 0;
+    EA = 1;
+    for (i = 0; i < SCHED_TASK_MAX; i++) SchedTasks[i] = 0;
+    SchedResetStats();
+}
+
+/**
+ * @brief Installs a task.
+ * @param Id Task ID from SCHED_TASK_ID().
+ * @param Task Entry point.
+ */
+void SchedAddTask(uint8_t Id, SchedTask Task)
+{
+    if (Id < SCHED_TASK_MAX) SchedTasks[Id] = Task;
+}
+
+/**
+ * @brief Marks a task ready from the main loop.
+ * @param Id Task ID.
+ */
+void SchedSignal(uint8_t Id)
+{
+    uint8_t mask = 1 << (Id & 7);
+
+    if (Id >= SCHED_TASK_MAX) return;
+    EA = 0;
+    if ((SchedReady[Id >> 3] & mask) == 0)
+    {
+        TIME_NOW_TICKS_ISR(SchedReadyAt[Id]);
+        SchedReady[Id >> 3] |= mask;
+    }
+    EA = 1;
+}
+
+/**
+ * @brief Runs the highest-priority ready task once.
+ * @details Returning after every task lets a higher-priority signal raised
+ *          meanwhile win the next dispatch.
+ * @return bit 1 if a task ran, 0 if nothing was ready.
+ */
+bit SchedRun(void)
+{
+    uint8_t level, index, mask, id;
+    SchedStats xdata* stats;
+    uint32_t start, time;
+
+    for (level = 0; level < SCHED_LEVELS; level++)
+    {
+        mask = SchedReady[level];
+        if (mask) break;
+    }
+    if (level == SCHED_LEVELS) return 0;
+    for (index = 0; (mask & 1) == 0; index++) mask >>= 1;
+    id = (level << 3) | index;
+
+    EA = 0;
+    SchedReady[level] &= ~(1 << index);
+    TIME_NOW_TICKS_ISR(start);
+    time = start - SchedReadyAt[id];
+    TRACE_ISR(TRACE_EV_TASK_BEGIN, id);
+    EA = 1;
+
+    stats = &SchedTaskStats[id];
+    stats->LatencyLast = time;
+    if (time > stats->LatencyMax) stats->LatencyMax = time;
+
+    SchedCurrent = id;
+    if (SchedTasks[id]) SchedTasks[id]();
+    SchedCurrent = SCHED_TASK_NONE;
+
+    time = TimeElapsedTicks(start);
+    TraceEvent(TRACE_EV_TASK_END, id);
+    stats->Runs++;
+    stats->ExecLast = time;
+    if (time > stats->ExecMax) stats->ExecMax = time;
+    return 1;
+}
+
+/**
+ * @brief Returns the statistics of a task.
+ * @param Id Task ID.
+ * @return SchedStats* Statistics record.
+ */
+SchedStats xdata* SchedGetStats(uint8_t Id)
+{
+    return &SchedTaskStats[Id < SCHED_TASK_MAX ? Id : 0];
+}
+
+/**
+ * @brief Clears the statistics of all tasks.
+ */
+void SchedResetStats(void)
+{
+    uint8_t i;
+    SchedStats xdata* stats;
+
+    for (i = 0; i < SCHED_TASK_MAX; i++)
+    {
+        stats = &SchedTaskStats[i];
+        stats->Runs = 0;
+        stats->ExecLast = 0;
+        stats->ExecMax = 0;
+        stats->LatencyLast = 0;
+        stats->LatencyMax = 0;
+    }
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
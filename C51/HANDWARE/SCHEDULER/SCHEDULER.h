@@ -0,0 +1,199 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "TimeStamp.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def SCHED_LEVELS
+ * @brief Number of priority levels, 8 tasks per level.
+ */
+#define SCHED_LEVELS			3
+
+/**
+ * @def SCHED_TASK_MAX
+ * @brief Number of task slots.
+ */
+#define SCHED_TASK_MAX			(SCHED_LEVELS * 8)
+
+/**
+ * @def SCHED_PRIO_HIGH
+ * @brief Highest priority level.
+ */
+#define SCHED_PRIO_HIGH			0
+
+/**
+ * @def SCHED_PRIO_MID
+ * @brief Middle priority level.
+ */
+#define SCHED_PRIO_MID			1
+
+/**
+ * @def SCHED_PRIO_LOW
+ * @brief Lowest priority level.
+ */
+#define SCHED_PRIO_LOW			2
+
+/**
+ * @def SCHED_TASK_ID
+ * @brief Builds a task ID from its priority level and index (0 to 7).
+ * @details Within a level, the lower index runs first.
+ */
+#define SCHED_TASK_ID(Prio, Index)	(((Prio) << 3) | (Index))
+
+/**
+ * @def SCHED_TASK_NONE
+ * @brief No task (SchedCurrent between tasks).
+ */
+#define SCHED_TASK_NONE			0xFF
+
+/**
+ * @def SCHED_TASK_UART
+ * @brief UART frame processing, signaled by the UART RX interrupts.
+ */
+#define SCHED_TASK_UART			SCHED_TASK_ID(SCHED_PRIO_HIGH, 0)
+
+/**
+ * @def SCHED_TASK_TIMER
+ * @brief Software timer wheel, signaled by the Timer2 tick.
+ */
+#define SCHED_TASK_TIMER		SCHED_TASK_ID(SCHED_PRIO_MID, 0)
+
+/**
+ * @def SCHED_TASK_APP
+ * @brief Application logic, signaled once per second.
+ */
+#define SCHED_TASK_APP			SCHED_TASK_ID(SCHED_PRIO_LOW, 0)
+
+/**
+ * @def SCHED_SIGNAL_ISR
+ * @brief Marks a task ready from an interrupt routine.
+ * @details Only the first signal of a pending run is time-stamped, so the
+ *          latency covers the whole wait. Use SchedSignal() in the main loop.
+ * @param Id Task ID (constant).
+ */
+#define SCHED_SIGNAL_ISR(Id) \
+{ \
+    if ((SchedReady[(Id) >> 3] & (1 << ((Id) & 7))) == 0) \
+    { \
+        TIME_NOW_TICKS_ISR(SchedReadyAt[Id]); \
+        SchedReady[(Id) >> 3] |= (1 << ((Id) & 7)); \
+    } \
+}
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief Task entry point.
+ * @details Tasks run to completion. They are called through a function
+ *          pointer, which Keil's overlay analysis cannot follow: each one is
+ *          listed in the linker OVERLAY directive of template.uvproj as
+ *          "SchedRun ! task" plus "AppInit ~ task" for the function passing
+ *          it to SchedAddTask(). Add new tasks there.
+ */
+typedef void (*SchedTask)(void);
+
+/**
+ * @brief Per-task statistics, times in Timer2 counts (TIME_TICKS_PER_MS per ms).
+ */
+typedef struct
+{
+    uint32_t Runs;             ///< Number of runs.
+    uint32_t ExecLast;         ///< Execution time of the last run.
+    uint32_t ExecMax;          ///< Longest execution time.
+    uint32_t LatencyLast;      ///< Signal-to-run latency of the last run.
+    uint32_t LatencyMax;       ///< Longest signal-to-run latency.
+} SchedStats;
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Ready bitmap per priority level. */
+extern uint8_t data SchedReady[SCHED_LEVELS];
+
+/** @brief Task running now, SCHED_TASK_NONE between tasks. */
+extern uint8_t data SchedCurrent;
+
+/** @brief Tick timestamp at which each task became ready. */
+extern uint32_t xdata SchedReadyAt[SCHED_TASK_MAX];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears the task table, ready bitmaps and statistics.
+ */
+void SchedInit(void);
+
+/**
+ * @brief Installs a task.
+ * @param Id Task ID from SCHED_TASK_ID().
+ * @param Task Entry point.
+ */
+void SchedAddTask(uint8_t Id, SchedTask Task);
+
+/**
+ * @brief Marks a task ready from the main loop.
+ * @param Id Task ID.
+ */
+void SchedSignal(uint8_t Id);
+
+/**
+ * @brief Runs the highest-priority ready task once.
+ * @return bit 1 if a task ran, 0 if nothing was ready.
+ */
+bit SchedRun(void);
+
+/**
+ * @brief Returns the statistics of a task.
+ * @param Id Task ID.
+ * @return SchedStats* Statistics record.
+ */
+SchedStats xdata* SchedGetStats(uint8_t Id);
+
+/**
+ * @brief Clears the statistics of all tasks.
+ */
+void SchedResetStats(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,275 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SPI.h"
+#if SPI_BENCH_ENABLE
+#include "TimeStamp.h"
+#endif
+
+#if SPI_ENABLE
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+// One bit, MSB first. Idle is the SCK level between bytes (CPOL). The
+// masks are constants, so each bit is a test and two SCK bit writes.
+
+/**
+ * @def SPI_BIT_CPHA0
+ * @brief Data out before the leading edge, sampled on the leading edge.
+ */
+#define SPI_BIT_CPHA0(Out, In, Mask, Idle) \
+{ \
+    GPIO_WRITE(SPI_MOSI_PIN, (Out) & (Mask)); \
+    GPIO_WRITE(SPI_SCK_PIN, !(Idle)); \
+    if (GPIO_READ(SPI_MISO_PIN)) (In) |= (Mask); \
+    GPIO_WRITE(SPI_SCK_PIN, (Idle)); \
+}
+
+/**
+ * @def SPI_BIT_CPHA1
+ * @brief Data out on the leading edge, sampled on the trailing edge.
+ */
+#define SPI_BIT_CPHA1(Out, In, Mask, Idle) \
+{ \
+    GPIO_WRITE(SPI_SCK_PIN, !(Idle)); \
+    GPIO_WRITE(SPI_MOSI_PIN, (Out) & (Mask)); \
+    GPIO_WRITE(SPI_SCK_PIN, (Idle)); \
+    if (GPIO_READ(SPI_MISO_PIN)) (In) |= (Mask); \
+}
+
+/**
+ * @def SPI_BYTE
+ * @brief Eight unrolled bits of one mode.
+ */
+#define SPI_BYTE(Bit, Out, In, Idle) \
+{ \
+    Bit(Out, In, 0x80, Idle); \
+    Bit(Out, In, 0x40, Idle); \
+    Bit(Out, In, 0x20, Idle); \
+    Bit(Out, In, 0x10, Idle); \
+    Bit(Out, In, 0x08, Idle); \
+    Bit(Out, In, 0x04, Idle); \
+    Bit(Out, In, 0x02, Idle); \
+    Bit(Out, In, 0x01, Idle); \
+}
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static uint8_t SpiMode;						///< Mode of the selected device.
+static const SpiDevice *SpiDev;				///< Selected device, 0 if none.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Exchanges one byte in mode 0.
+ */
+static uint8_t SpiByte0(uint8_t Out)
+{
+    uint8_t in = 0;
+
+    SPI_BYTE(SPI_BIT_CPHA0, Out, in, 0);
+    return in;
+}
+
+/**
+ * @brief Exchanges one byte in mode 1.
+ */
+static uint8_t SpiByte1(uint8_t Out)
+{
+    uint8_t in = 0;
+
+    SPI_BYTE(SPI_BIT_CPHA1, Out, in, 0);
+    return in;
+}
+
+/**
+ * @brief Exchanges one byte in mode 2.
+ */
+static uint8_t SpiByte2(uint8_t Out)
+{
+    uint8_t in = 0;
+
+    SPI_BYTE(SPI_BIT_CPHA0, Out, in, 1);
+    return in;
+}
+
+/**
+ * @brief Exchanges one byte in mode 3.
+ */
+static uint8_t SpiByte3(uint8_t Out)
+{
+    uint8_t in = 0;
+
+    SPI_BYTE(SPI_BIT_CPHA1, Out, in, 1);
+    return in;
+}
+
+/**
+ * @brief Configures SPI_SCK_PIN and SPI_MOSI_PIN as push-pull outputs and SPI_MISO_PIN as input.
+ */
+void SpiInit(void)
+{
+    InitGpio(GPIO_OUT, SPI_SCK_PIN, GPIO_LOW);
+    InitGpio(GPIO_OUT, SPI_MOSI_PIN, GPIO_LOW);
+    InitGpio(GPIO_IN, SPI_MISO_PIN, GPIO_LOW);
+    SpiMode = SPI_MODE_0;
+    SpiDev = 0;
+}
+
+/**
+ * @brief Configures the chip select of a device as an output, deselected.
+ * @param Dev Device.
+ */
+void SpiAttach(const SpiDevice *Dev)
+{
+    InitGpio(GPIO_OUT, Dev->CsPort, Dev->CsPin, GPIO_HIGHT);
+}
+
+/**
+ * @brief Selects a device: SCK to the idle level of its mode, then chip select low.
+ * @param Dev Device.
+ */
+void SpiBegin(const SpiDevice *Dev)
+{
+    SpiMode = Dev->Mode & 0x03;
+    GPIO_WRITE(SPI_SCK_PIN, SpiMode & 0x02);
+    SpiDev = Dev;
+    SetGpioOutState(Dev->CsPort, Dev->CsPin, GPIO_LOW);
+}
+
+/**
+ * @brief Deselects the device selected by SpiBegin().
+ */
+void SpiEnd(void)
+{
+    if (SpiDev == 0) return;
+    SetGpioOutState(SpiDev->CsPort, SpiDev->CsPin, GPIO_HIGHT);
+    SpiDev = 0;
+}
+
+/**
+ * @brief Exchanges one byte, MSB first.
+ * @param Out Byte to send.
+ * @return uint8_t Byte received.
+ */
+uint8_t SpiTransfer(uint8_t Out)
+{
+    switch (SpiMode)
+    {
+    case SPI_MODE_0: return SpiByte0(Out);
+    case SPI_MODE_1: return SpiByte1(Out);
+    case SPI_MODE_2: return SpiByte2(Out);
+    }
+    return SpiByte3(Out);
+}
+
+/**
+ * @brief Sends a block, discarding the received bytes.
+ * @param Buf Bytes to send.
+ * @param Len Number of bytes.
+ */
+void SpiWrite(const uint8_t *Buf, uint16_t Len)
+{
+    //Mode chosen once per block, not per byte
+    switch (SpiMode)
+    {
+    case SPI_MODE_0: while (Len--) SpiByte0(*Buf++); break;
+    case SPI_MODE_1: while (Len--) SpiByte1(*Buf++); break;
+    case SPI_MODE_2: while (Len--) SpiByte2(*Buf++); break;
+    default:         while (Len--) SpiByte3(*Buf++); break;
+    }
+}
+
+/**
+ * @brief Receives a block, sending SPI_FILL.
+ * @param Buf Receives the bytes.
+ * @param Len Number of bytes.
+ */
+void SpiRead(uint8_t *Buf, uint16_t Len)
+{
+    switch (SpiMode)
+    {
+    case SPI_MODE_0: while (Len--) *Buf++ = SpiByte0(SPI_FILL); break;
+    case SPI_MODE_1: while (Len--) *Buf++ = SpiByte1(SPI_FILL); break;
+    case SPI_MODE_2: while (Len--) *Buf++ = SpiByte2(SPI_FILL); break;
+    default:         while (Len--) *Buf++ = SpiByte3(SPI_FILL); break;
+    }
+}
+
+#if SPI_BENCH_ENABLE
+/**
+ * @brief Converts the time of 256 bytes to an SCK rate in kHz.
+ */
+static uint16_t SpiBenchKhz(uint32_t Ticks)
+{
+    if (Ticks == 0) Ticks = 1;
+    return (uint16_t)((2048UL * TIME_TICKS_PER_MS) / Ticks);
+}
+
+/**
+ * @brief Measures the SCK rate of each mode and writes it to SPI_BENCH_VP.
+ */
+void SpiBench(void)
+{
+    static xdata uint8_t buf[64];
+    uint16_t result[6];
+    uint32_t start;
+    uint8_t mode, run;
+
+    for (mode = SPI_MODE_0; mode <= SPI_MODE_3; mode++)
+    {
+        SpiMode = mode;
+        GPIO_WRITE(SPI_SCK_PIN, mode & 0x02);
+        start = TimeNowTicks();
+        for (run = 0; run < 4; run++) SpiWrite(buf, sizeof(buf));
+        result[mode] = SpiBenchKhz(TimeElapsedTicks(start));
+    }
+
+    SpiMode = SPI_MODE_0;
+    GPIO_CLR(SPI_SCK_PIN);
+    start = TimeNowTicks();
+    for (run = 0; run < 255; run++) SpiTransfer(run);
+    SpiTransfer(run);
+    result[4] = SpiBenchKhz(TimeElapsedTicks(start));
+
+    BenchReport(SPI_BENCH_VP, result, 5);
+}
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,131 @@
+#ifndef __SPI_H__
+#define __SPI_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "GPIO.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define SPI_MODE_0				0	///< CPOL 0, CPHA 0: SCK idles low, data sampled on the rising edge.
+#define SPI_MODE_1				1	///< CPOL 0, CPHA 1: SCK idles low, data sampled on the falling edge.
+#define SPI_MODE_2				2	///< CPOL 1, CPHA 0: SCK idles high, data sampled on the falling edge.
+#define SPI_MODE_3				3	///< CPOL 1, CPHA 1: SCK idles high, data sampled on the rising edge.
+
+/**
+ * @def SPI_FILL
+ * @brief Byte shifted out by SpiRead().
+ */
+#define SPI_FILL				0xFF
+
+/**
+ * @brief A device on the SPI bus: its chip select and mode.
+ * @details Usually a code constant, the chip select given as a pin
+ *          descriptor, e.g.
+ *          @code static code SpiDevice Eeprom = {EEPROM_CS, SPI_MODE_0}; @endcode
+ */
+typedef struct
+{
+    uint8_t CsPort;         ///< Chip select port (active low).
+    uint8_t CsPin;          ///< Chip select pin.
+    uint8_t Mode;           ///< SPI_MODE_0 to SPI_MODE_3.
+} SpiDevice;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if SPI_ENABLE
+/**
+ * @brief Configures SPI_SCK_PIN and SPI_MOSI_PIN as push-pull outputs and SPI_MISO_PIN as input.
+ */
+void SpiInit(void);
+
+/**
+ * @brief Configures the chip select of a device as an output, deselected.
+ * @param Dev Device.
+ */
+void SpiAttach(const SpiDevice *Dev);
+
+/**
+ * @brief Selects a device: SCK to the idle level of its mode, then chip select low.
+ * @details The bus stays held until SpiEnd(), so any number of SpiTransfer(),
+ *          SpiWrite() and SpiRead() calls form one transaction. Main loop only.
+ * @param Dev Device.
+ */
+void SpiBegin(const SpiDevice *Dev);
+
+/**
+ * @brief Deselects the device selected by SpiBegin().
+ */
+void SpiEnd(void);
+
+/**
+ * @brief Exchanges one byte, MSB first.
+ * @param Out Byte to send.
+ * @return uint8_t Byte received.
+ */
+uint8_t SpiTransfer(uint8_t Out);
+
+/**
+ * @brief Sends a block, discarding the received bytes.
+ * @param Buf Bytes to send.
+ * @param Len Number of bytes.
+ */
+void SpiWrite(const uint8_t *Buf, uint16_t Len);
+
+/**
+ * @brief Receives a block, sending SPI_FILL.
+ * @param Buf Receives the bytes.
+ * @param Len Number of bytes.
+ */
+void SpiRead(uint8_t *Buf, uint16_t Len);
+
+#if SPI_BENCH_ENABLE
+/**
+ * @brief Measures the SCK rate of each mode and writes it to SPI_BENCH_VP.
+ * @details Clocks 256 bytes per mode with no device selected. Results in
+ *          kHz: [0-3] SpiWrite() in modes 0-3, [4] SpiTransfer() called per
+ *          byte in mode 0, [5] TIME_TICKS_PER_MS. The SCK duty is not 50 %:
+ *          check the high and low times against the device limits.
+ */
+void SpiBench(void);
+#endif
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -42,15 +42,372 @@ SOFTWARE.
 
 /**
  * @def TIMER_0_ENABLE
- * @brief Enable Timer0 (1 = enabled).
+ * @brief Enable Timer0 1 ms interrupt (0 = free for other uses).
+ * @details The system tick comes from Timer2 only.
  */
-#define TIMER_0_ENABLE				1
+#define TIMER_0_ENABLE				0
 
 /**
  * @def TIMER_1_ENABLE
- * @brief Enable Timer1 (1 = enabled).
+ * @brief Enable Timer1 1 ms interrupt (0 = free for other uses).
+ * @details The system tick comes from Timer2 only.
  */
-#define TIMER_1_ENABLE				1
+#define TIMER_1_ENABLE				0
+
+/**
+ * @def SOFT_TIMER_COUNT
+ * @brief Number of software timers in the timer wheel (max 254).
+ */
+#define SOFT_TIMER_COUNT			16
+
+/**
+ * @def DELAY_IDLE_ENABLE
+ * @brief Idle the CPU (PCON) between ticks in SysDelayMs (0 = busy-wait).
+ */
+#define DELAY_IDLE_ENABLE			1
+
+/**
+ * @def TRACE_ENABLE
+ * @brief Enable the event trace ring and its UART dump command.
+ */
+#define TRACE_ENABLE				1
+
+/**
+ * @def TRACE_ISR_ENABLE
+ * @brief Also trace ISR entry/exit (fills the ring at ~2 events per ms).
+ */
+#define TRACE_ISR_ENABLE			0
+
+/**
+ * @def TRACE_DEPTH
+ * @brief Trace ring entries (power of two, max 256; 7 bytes XDATA each).
+ */
+#define TRACE_DEPTH					256
+
+/**
+ * @def DIAG_ENABLE
+ * @brief Enable CPU load and loop latency instrumentation.
+ */
+#define DIAG_ENABLE					1
+
+/**
+ * @def DIAG_VP
+ * @brief First VP of the diagnostics block, refreshed once per second (DIAG_VP_WORDS words).
+ */
+#define DIAG_VP						0x0F40
+
+/**
+ * @def WDT_SUP_ENABLE
+ * @brief Enable the hardware watchdog under the task-heartbeat supervisor.
+ */
+#define WDT_SUP_ENABLE				1
+
+/**
+ * @def WDT_SUP_TASKS
+ * @brief Number of tasks the supervisor can watch.
+ */
+#define WDT_SUP_TASKS				4
+
+/**
+ * @def WDT_SUP_PERIOD_MS
+ * @brief Supervisor check and refresh period (well below the ~1 s hardware timeout).
+ */
+#define WDT_SUP_PERIOD_MS			100
+
+/**
+ * @def WDT_SUP_STALL_MS
+ * @brief Time without a supervisor pass after which the running task is blamed.
+ * @details Must be longer than WDT_SUP_PERIOD_MS and shorter than the hardware timeout.
+ */
+#define WDT_SUP_STALL_MS			500
+
+/**
+ * @def WDT_SUP_VP
+ * @brief VP of the supervisor fault record (WDT_SUP_VP_WORDS words).
+ */
+#define WDT_SUP_VP					0x0F70
+
+/**
+ * @def ADC_SAMPLER_ENABLE
+ * @brief Enable the background ADC sampler (per-channel rings of AD_VALUE snapshots).
+ */
+#define ADC_SAMPLER_ENABLE			1
+
+/**
+ * @def ADC_RING_LOG2
+ * @brief Decimated samples kept per channel as a power of two, 1 << ADC_RING_LOG2
+ *        (max 7; 2 bytes XDATA each, 7 channels). AdcGetAvg() shifts instead of dividing.
+ */
+#define ADC_RING_LOG2				4
+
+/**
+ * @def FILTER_MA_BITS_MAX
+ * @brief Largest moving-average window of the filter library, as log2 (4 = 16 samples).
+ */
+#define FILTER_MA_BITS_MAX			4
+
+/**
+ * @def FILTER_MEDIAN_MAX
+ * @brief Largest median window of the filter library (odd, a few samples).
+ */
+#define FILTER_MEDIAN_MAX			5
+
+/**
+ * @def CAL_POINTS_MAX
+ * @brief Points per channel of a field calibration (8 bytes XDATA each, 7 channels).
+ * @details CODE tables from CalTable.c are not limited by this.
+ */
+#define CAL_POINTS_MAX				8
+
+/**
+ * @def CAL_VP
+ * @brief First VP of the field calibration block (CAL_VP_WORDS words, even).
+ */
+#define CAL_VP						0x1000
+
+/**
+ * @def CAL_NOR_ENABLE
+ * @brief Load field calibrations from NOR flash at start-up (CalSaveNor() stores them).
+ */
+#define CAL_NOR_ENABLE				1
+
+/**
+ * @def CAL_NOR_ADDR
+ * @brief NOR flash database word address of the saved field calibrations (even).
+ */
+#define CAL_NOR_ADDR				0x001000
+
+/**
+ * @def NOR_FLASH_POLL_MAX
+ * @brief NOR_FLASH register polls before a NOR database request is abandoned (NOR_TIMEOUT).
+ * @details Counted in polls, not ms: CalInit() runs before Timer2 is started.
+ *          One poll is one ReadDgus(), so this is well above a flash write.
+ */
+#define NOR_FLASH_POLL_MAX			200000UL
+
+/**
+ * @def ALARM_ENABLE
+ * @brief Enable the alarm table engine (rules in AlarmTable.c, shipped empty).
+ */
+#define ALARM_ENABLE				0
+
+/**
+ * @def ALARM_RULES_MAX
+ * @brief Rules the engine keeps state for (5 bytes XDATA each); extra AlarmRules entries are ignored.
+ */
+#define ALARM_RULES_MAX				16
+
+/**
+ * @def ALARM_PERIOD_MS
+ * @brief Alarm evaluation tick.
+ */
+#define ALARM_PERIOD_MS				50
+
+/**
+ * @def ALARM_RULES_PER_TICK
+ * @brief Rules visited per tick (4 every 50 ms = at most 80 rules per second).
+ */
+#define ALARM_RULES_PER_TICK		4
+
+/**
+ * @def INPUT_ENABLE
+ * @brief Enable the debounced input scanner in Timer2Isr.
+ */
+#define INPUT_ENABLE				1
+
+/**
+ * @def INPUT_SCAN_MS
+ * @brief Scan period; a level must hold for 4 scans to be accepted.
+ */
+#define INPUT_SCAN_MS				5
+
+/**
+ * @def INPUT_MASK_P0
+ * @brief Scanned pins of port 0 (bit n = pin n).
+ */
+#define INPUT_MASK_P0				0x00
+
+/**
+ * @def INPUT_MASK_P1
+ * @brief Scanned pins of port 1.
+ */
+#define INPUT_MASK_P1				0x00
+
+/**
+ * @def INPUT_MASK_P2
+ * @brief Scanned pins of port 2.
+ */
+#define INPUT_MASK_P2				0x00
+
+/**
+ * @def INPUT_MASK_P3
+ * @brief Scanned pins of port 3 (pins 0 to 3 only).
+ */
+#define INPUT_MASK_P3				0x00
+
+/**
+ * @def INPUT_LONG_MASK_P0
+ * @brief Pins of port 0 reporting a long press (held low); subset of INPUT_MASK_P0.
+ */
+#define INPUT_LONG_MASK_P0			0x00
+
+/**
+ * @def INPUT_LONG_MASK_P1
+ * @brief Pins of port 1 reporting a long press.
+ */
+#define INPUT_LONG_MASK_P1			0x00
+
+/**
+ * @def INPUT_LONG_MASK_P2
+ * @brief Pins of port 2 reporting a long press.
+ */
+#define INPUT_LONG_MASK_P2			0x00
+
+/**
+ * @def INPUT_LONG_MASK_P3
+ * @brief Pins of port 3 reporting a long press.
+ */
+#define INPUT_LONG_MASK_P3			0x00
+
+/**
+ * @def INPUT_LONG_MS
+ * @brief Hold time of a long press.
+ */
+#define INPUT_LONG_MS				1000
+
+/**
+ * @def INPUT_QUEUE_DEPTH
+ * @brief Event queue entries (power of two, max 256; 1 byte XDATA each).
+ */
+#define INPUT_QUEUE_DEPTH			16
+
+/**
+ * @def PULSE_ENABLE
+ * @brief Enable the INT0 (P3.2) / INT1 (P3.3) pulse counters; keep those pins out of INPUT_MASK_P3.
+ */
+#define PULSE_ENABLE				0
+
+/**
+ * @def PULSE_GATE_MS
+ * @brief Frequency/period update and VP publish interval.
+ */
+#define PULSE_GATE_MS				1000
+
+/**
+ * @def PULSE_TIMEOUT_MS
+ * @brief Time without an edge after which frequency and period read 0.
+ */
+#define PULSE_TIMEOUT_MS			3000
+
+/**
+ * @def PULSE_VP
+ * @brief First VP of the pulse counter block (PULSE_VP_STRIDE words per channel).
+ */
+#define PULSE_VP					0x1300
+
+/**
+ * @def SPI_ENABLE
+ * @brief Enable the bit-banged SPI master.
+ * @details Off by default: SpiInit() drives SCK and MOSI push-pull at boot.
+ */
+#ifndef SPI_ENABLE
+#define SPI_ENABLE					0
+#endif
+
+/**
+ * @def SPI_SCK_PIN
+ * @brief SPI clock, push-pull ("port, pin" descriptor, see GPIO_SET).
+ */
+#define SPI_SCK_PIN					GPIO_PORT_1, GPIO_PIN_5
+
+/**
+ * @def SPI_MOSI_PIN
+ * @brief SPI data out, push-pull.
+ */
+#define SPI_MOSI_PIN				GPIO_PORT_1, GPIO_PIN_6
+
+/**
+ * @def SPI_MISO_PIN
+ * @brief SPI data in.
+ */
+#define SPI_MISO_PIN				GPIO_PORT_1, GPIO_PIN_7
+
+/**
+ * @def I2C_ENABLE
+ * @brief Enable the bit-banged I2C master (external pull-ups required).
+ * @details Off by default: I2cInit() clocks SCL at boot to free the bus.
+ */
+#ifndef I2C_ENABLE
+#define I2C_ENABLE					0
+#endif
+
+/**
+ * @def I2C_SCL_PIN
+ * @brief I2C clock, open-drain ("port, pin" descriptor, see GPIO_SET).
+ */
+#define I2C_SCL_PIN					GPIO_PORT_2, GPIO_PIN_0
+
+/**
+ * @def I2C_SDA_PIN
+ * @brief I2C data, open-drain.
+ */
+#define I2C_SDA_PIN					GPIO_PORT_2, GPIO_PIN_1
+
+/**
+ * @def I2C_DELAY
+ * @brief Busy-wait passes per half SCL period (0 to 255, 0 = none); set from I2cBench().
+ */
+#define I2C_DELAY					60
+
+/**
+ * @def I2C_STRETCH_MAX
+ * @brief SCL polls before a stretching slave is reported as I2C_TIMEOUT (1 to 65535).
+ */
+#define I2C_STRETCH_MAX				20000
+
+/**
+ * @def BENCH_VP
+ * @brief First VP of the start-up microbenchmark results (BENCH_VP to BENCH_VP + 0x20).
+ * @details Every *_BENCH_ENABLE bench writes its own slot, laid out in
+ *          TimeStamp.h; the last word of a slot is TIME_TICKS_PER_MS.
+ */
+#define BENCH_VP					0x0F10
+
+/**
+ * @def ADC_BENCH_ENABLE
+ * @brief Run the per-channel vs burst ADC read microbenchmark at start-up (0 = disabled).
+ */
+#define ADC_BENCH_ENABLE			0
+
+/**
+ * @def PWM_BENCH_ENABLE
+ * @brief Run the PWM/DAC scaling microbenchmark at start-up (0 = disabled).
+ */
+#define PWM_BENCH_ENABLE			0
+
+/**
+ * @def GPIO_BENCH_ENABLE
+ * @brief Run the GPIO write microbenchmark at start-up (0 = disabled).
+ */
+#define GPIO_BENCH_ENABLE			0
+
+/**
+ * @def PULSE_BENCH_ENABLE
+ * @brief Run the INT0 edge cost microbenchmark at start-up (0 = disabled).
+ */
+#define PULSE_BENCH_ENABLE			0
+
+/**
+ * @def SPI_BENCH_ENABLE
+ * @brief Run the SPI clock rate microbenchmark at start-up (0 = disabled).
+ */
+#define SPI_BENCH_ENABLE			0
+
+/**
+ * @def I2C_BENCH_ENABLE
+ * @brief Run the I2C clock rate microbenchmark at start-up (0 = disabled).
+ */
+#define I2C_BENCH_ENABLE			0
 
 /**
  * @def UART_CONNECT_CONTROL
@@ -214,6 +571,24 @@ SOFTWARE.
  */
 #define CRC_CHECK_UART5				0
 
+/**
+ * @def CRC16_MODE
+ * @brief CRC16 implementation (0 = full table, 1 = nibble table, 2 = bitwise).
+ * @details 0: two 256-byte tables in CODE, fastest.
+ *          1: one 16-word table in CODE (32 bytes), two lookups per byte.
+ *          2: no table, eight shift/xor steps per byte.
+ *          None of them uses XDATA. Per-mode costs: CRC16.h; Crc16Bench() measures the selected one.
+ */
+#ifndef CRC16_MODE
+#define CRC16_MODE					0
+#endif
+
+/**
+ * @def CRC_BENCH_ENABLE
+ * @brief Run the CRC16 streaming/block microbenchmark at start-up (0 = disabled).
+ */
+#define CRC_BENCH_ENABLE			0
+
 /**
  * @def DELAY_UART2
  * @brief UART2 communication delay (5 units).
@@ -238,12 +613,66 @@ SOFTWARE.
  */
 #define DELAY_UART5					5
 
+/**
+ * @def CHECKSUM_CCITT_ENABLE
+ * @brief Build CRC-16/CCITT into the checksum engine (512 bytes CODE).
+ */
+#define CHECKSUM_CCITT_ENABLE		1
+
+/**
+ * @def CHECKSUM_CRC32_ENABLE
+ * @brief Build CRC-32 into the checksum engine (1024 bytes CODE).
+ */
+#define CHECKSUM_CRC32_ENABLE		1
+
 /**
  * @def PWM_ACCURACY
  * @brief PWM resolution (0x2042 = 8258 for 13-bit precision).
  */
 #define PWM_ACCURACY				0x2042
 
+/**
+ * @def PWM_OUT_INTERVAL_MS
+ * @brief Minimum time between two PWM/DAC frames to the UART3 co-processor.
+ */
+#define PWM_OUT_INTERVAL_MS			10
+
+/**
+ * @def PWM_INIT_POLL_MS
+ * @brief Poll period of the PWM/DAC init acknowledge.
+ */
+#define PWM_INIT_POLL_MS			1
+
+/**
+ * @def PWM_INIT_TIMEOUT_MS
+ * @brief Time PwmInit()/DacInit() wait for the acknowledge before reporting PWM_INIT_TIMEOUT.
+ */
+#define PWM_INIT_TIMEOUT_MS			100
+
+/**
+ * @def WAVE_PERIOD_MS
+ * @brief Waveform sample period (divides 1000, at least PWM_OUT_INTERVAL_MS).
+ */
+#define WAVE_PERIOD_MS				10
+
+/**
+ * @def PID_ENABLE
+ * @brief Enable the PID loop service (needs ADC_SAMPLER_ENABLE).
+ */
+#define PID_ENABLE					1
+
+/**
+ * @def PID_LOOPS
+ * @brief Number of PID loops (20 bytes XDATA each).
+ */
+#define PID_LOOPS					2
+
+/**
+ * @def PID_VP
+ * @brief First VP of the PID blocks (PID_LOOPS * PID_VP_STRIDE words).
+ */
+#define PID_VP						0x1200
+
 /**
  * @def DTHD1
  * @brief DGUS protocol header byte 1 (0x5A).
@@ -35,6 +35,14 @@ SOFTWARE.
 #include "IrqMap.h" 
 #include "UART.h"   
 #include "TIMER.h"  
+#include "SoftTimer.h"
+#include "SCHEDULER.h"
+#include "TimeStamp.h"
+#include "TRACE.h"
+#include "DIAG.h"
+#include "WDT.h"
+#include "INPUT.h"
+#include "PULSE.h"
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
@@ -43,30 +51,12 @@ SOFTWARE.
 //==============================================================================
 //---------------------------------VARIABLES------------------------------------
 //==============================================================================
-/**
- * @var uint32_t DelayMsTick
- * @brief Global tick counter for millisecond delays.
- */
-uint32_t DelayMsTick = 0;
-
-/**
- * @var uint32_t Uptime
- * @brief System uptime counter in seconds.
- */
-extern uint32_t Uptime;
-
 /**
  * @var uint32_t CntMs
  * @brief Millisecond counter for uptime tracking.
  */
 uint32_t CntMs;
 
-/**
- * @var uint32_t SysTimCnt
- * @brief System timer counter.
- */
-extern uint32_t SysTimCnt;
-
 /**
  * @var uint32_t Tim0Cnt
  * @brief Timer0 interrupt counter.
@@ -82,6 +72,16 @@ uint32_t Tim1Cnt;
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
+#if PULSE_ENABLE
+/**
+ * @brief Interrupt service routine for external interrupt 0.
+ * Counts and timestamps a pulse edge on INT0; kept free of tracing so the input rate stays high.
+ */
+void ExternaPin0Irq(void) interrupt 0
+{
+    PULSE_EDGE_ISR(0);
+}
+#else
 /**
  * @brief Interrupt service routine for external interrupt 0.
  */
@@ -90,19 +90,31 @@ void ExternaPin0Irq(void) interrupt 0
     EA = 0; // Disable global interrupts
     EA = 1; // Re-enable global interrupts
 }
+#endif
 
+#if TIMER_0_ENABLE
 /**
  * @brief Interrupt service routine for Timer0.
- * Reloads Timer0 and decrements DelayMsTick.
+ * Reloads Timer0 and counts its interrupts.
  */
 void Timer0Isr(void) interrupt 1
 {
     TH0 = (uint8_t)(T0_PERIOD_1MS >> 8); // Reload high byte
     TL0 = (uint8_t)T0_PERIOD_1MS;       // Reload low byte
     Tim0Cnt++;                 // Increment Timer0 counter
-    if (DelayMsTick) DelayMsTick--; // Decrement delay counter
 }
+#endif
 
+#if PULSE_ENABLE
+/**
+ * @brief Interrupt service routine for external interrupt 1.
+ * Counts and timestamps a pulse edge on INT1; kept free of tracing so the input rate stays high.
+ */
+void ExternaPin1Irq(void) interrupt 2
+{
+    PULSE_EDGE_ISR(1);
+}
+#else
 /**
  * @brief Interrupt service routine for external interrupt 1.
  */
@@ -111,35 +123,50 @@ void ExternaPin1Irq(void) interrupt 2
     EA = 0; // Disable global interrupts
     EA = 1; // Re-enable global interrupts
 }
+#endif
 
+#if TIMER_1_ENABLE
 /**
  * @brief Interrupt service routine for Timer1.
- * Reloads Timer1 and decrements DelayMsTick.
+ * Reloads Timer1 and counts its interrupts.
  */
 void Timer1Isr(void) interrupt 3
 {
     TH1 = (uint8_t)(T1_PERIOD_1MS >> 8); // Reload high byte
     TL1 = (uint8_t)T1_PERIOD_1MS;       // Reload low byte
     Tim1Cnt++;                 // Increment Timer1 counter
-    if (DelayMsTick) DelayMsTick--; // Decrement delay counter
 }
+#endif
 
 /**
  * @brief Interrupt service routine for Timer2.
- * Updates uptime, decrements DelayMsTick, and calls InterfaceDelay.
+ * Single 1 ms system tick: updates the time counters, feeds the watchdog stall detector,
+ * scans the debounced inputs, calls InterfaceDelay, advances the software timer wheel and signals
+ * the timer task every tick and the application task every second.
  */
 void Timer2Isr(void) interrupt 5
 {
+    TRACE_ISR_ENTER(5);
+    DIAG_ISR_ENTER();
+    EA = 0; // The high priority edge ISRs sample TimeTicks and TF2 together
 	SysTimCnt++;
+    TimeTicks += TIME_TICKS_PER_MS; // Keep the tick timestamp base in step
     TF2 = 0; // Clear Timer2 overflow flag
+    EA = 1;
     CntMs++; // Increment millisecond counter
-    if (DelayMsTick) DelayMsTick--; // Decrement delay counter
-    if (CntMs >= 999)
+    WDT_SUP_TICK_ISR(); // Watchdog supervisor stall detector
+    if (CntMs >= 1000)
     {
         CntMs = 0;
         Uptime++; // Increment uptime in seconds
+        SCHED_SIGNAL_ISR(SCHED_TASK_APP);
     }
+    INPUT_SCAN_TICK_ISR(); // Debounced input scan every INPUT_SCAN_MS
     InterfaceDelay(); // Handle UART interface delay
+    SoftTimerTick(); // Count a tick for the software timers
+    SCHED_SIGNAL_ISR(SCHED_TASK_TIMER);
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(5);
 }
 
 /**
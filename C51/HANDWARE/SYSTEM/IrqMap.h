@@ -52,20 +52,24 @@ SOFTWARE.
  */
 void ExternaPin0Irq(void);
 
+#if TIMER_0_ENABLE
 /**
  * @brief Interrupt service routine for Timer0.
  */
 void Timer0Isr(void);
+#endif
 
 /**
  * @brief Interrupt service routine for external interrupt 1.
  */
 void ExternaPin1Irq(void);
 
+#if TIMER_1_ENABLE
 /**
  * @brief Interrupt service routine for Timer1.
  */
 void Timer1Isr(void);
+#endif
 
 /**
  * @brief Interrupt service routine for Timer2.
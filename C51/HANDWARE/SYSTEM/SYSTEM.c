@@ -33,6 +33,7 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "SYSTEM.h"
+#include "TRACE.h"
 
 
 //==============================================================================
@@ -58,6 +59,7 @@ void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
     unsigned char i;
 
     EA = 0;
+    TRACE_ISR(TRACE_EV_DGUS_READ, Addr);
     i = (unsigned char)(Addr & 0x01);
     Addr = Addr / 2;
     ADR_H = 0x00;
@@ -86,6 +88,7 @@ void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
         }
     }
     RAMMODE = 0x00;
+    TRACE_ISR(TRACE_EV_DGUS_READ_END, 0);
 		EA = 1;
 }
 
@@ -103,6 +106,7 @@ void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
      */
 	uint8_t i;  
 	    EA = 0;
+	TRACE_ISR(TRACE_EV_DGUS_WRITE, Addr);
 	i = (uint8_t)(Addr&0x01);
 	Addr >>= 1;
 	ADR_H = 0x00;
@@ -137,6 +141,7 @@ void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
 		APP_EN = 1;
 	}
 	RAMMODE = 0x00;
+	TRACE_ISR(TRACE_EV_DGUS_WRITE_END, 0);
     EA = 1;
 }
 
@@ -167,6 +172,7 @@ void PageChange(uint16_t PageID)
      */
     uint8_t buf[4];
 
+    TraceEvent(TRACE_EV_PAGE, PageID);
     buf[0] = 0x5A;
     buf[1] = 0x01;
     buf[2] = (uint8_t)(PageID >> 8);
@@ -187,6 +193,7 @@ uint16_t ReadDgus(uint16_t DgusAddr)
      */
     uint16_t R_Dgus = 0;
     EA = 0;
+    TRACE_ISR(TRACE_EV_DGUS_READ, DgusAddr);
     ADR_H = 0x00;
     ADR_M = (uint8_t)((DgusAddr / 2) >> 8);
     ADR_L = (uint8_t)(DgusAddr / 2);
@@ -199,6 +206,7 @@ uint16_t ReadDgus(uint16_t DgusAddr)
     else
         R_Dgus = (DATA3 << 8) + DATA2;
     RAMMODE = 0x00;
+    TRACE_ISR(TRACE_EV_DGUS_READ_END, 0);
     EA = 1;
 
     return R_Dgus;
@@ -212,6 +220,7 @@ uint16_t ReadDgus(uint16_t DgusAddr)
 void WriteDgus(uint16_t DgusAddr, uint16_t Val)
 {
     EA = 0;
+    TRACE_ISR(TRACE_EV_DGUS_WRITE, DgusAddr);
     ADR_H = 0x00;
     ADR_M = (uint8_t)((DgusAddr / 2) >> 8);
     ADR_L = (uint8_t)(DgusAddr / 2);
@@ -237,9 +246,64 @@ void WriteDgus(uint16_t DgusAddr, uint16_t Val)
     APP_EN = 1;
     while (APP_EN);
     RAMMODE = 0x00;
+    TRACE_ISR(TRACE_EV_DGUS_WRITE_END, 0);
     EA = 1;
 }
 
+/**
+ * @brief Runs one NOR flash database request through the NOR_FLASH register.
+ * @param Mode 0x5A reads NOR into VP, 0xA5 writes VP into NOR.
+ * @param NorAddr NOR word address (even).
+ * @param VpAddr VP address (even).
+ * @param Len16 Number of 16-bit words (even).
+ * @return NorStatus NOR_OK, or NOR_TIMEOUT after NOR_FLASH_POLL_MAX polls.
+ */
+static NorStatus NorFlashAccess(uint8_t Mode, uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16)
+{
+    uint32_t polls = NOR_FLASH_POLL_MAX;
+    uint8_t buf[8];
+
+    buf[0] = Mode;
+    buf[1] = (uint8_t)(NorAddr >> 16);
+    buf[2] = (uint8_t)(NorAddr >> 8);
+    buf[3] = (uint8_t)NorAddr;
+    buf[4] = (uint8_t)(VpAddr >> 8);
+    buf[5] = (uint8_t)VpAddr;
+    buf[6] = (uint8_t)(Len16 >> 8);
+    buf[7] = (uint8_t)Len16;
+    WriteDgusVp(NOR_FLASH, buf, 4);
+    //Mode byte is cleared when done; polled, since Timer2 may not run yet
+    while (ReadDgus(NOR_FLASH) & 0xFF00)
+    {
+        if (--polls == 0) return NOR_TIMEOUT;
+    }
+    return NOR_OK;
+}
+
+/**
+ * @brief Copies words from the NOR flash database into VP memory.
+ * @param NorAddr NOR word address (even).
+ * @param VpAddr VP address (even).
+ * @param Len16 Number of 16-bit words (even).
+ * @return NorStatus NOR_OK, or NOR_TIMEOUT if the core never completed it.
+ */
+NorStatus NorFlashRead(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16)
+{
+    return NorFlashAccess(0x5A, NorAddr, VpAddr, Len16);
+}
+
+/**
+ * @brief Copies words from VP memory into the NOR flash database.
+ * @param NorAddr NOR word address (even).
+ * @param VpAddr VP address (even).
+ * @param Len16 Number of 16-bit words (even).
+ * @return NorStatus NOR_OK, or NOR_TIMEOUT if the core never completed it.
+ */
+NorStatus NorFlashWrite(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16)
+{
+    return NorFlashAccess(0xA5, NorAddr, VpAddr, Len16);
+}
+
 /**
  * @brief Initializes system configuration registers.
  */
@@ -157,6 +157,15 @@ typedef signed long     int32_t;
  */
 #define T1MS    				(65536-FOSC/12/1000)
 
+/**
+ * @brief Enum for NOR flash database request status.
+ */
+typedef enum
+{
+    NOR_OK = 0x00,      ///< Request completed.
+    NOR_TIMEOUT = 0xFF, ///< Not completed within NOR_FLASH_POLL_MAX polls.
+} NorStatus;
+
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
@@ -184,12 +193,37 @@ void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16);
 
 /**
  * @brief Reads a buffer from a DGUS variable pointer register.
+ * @details DGUS words are big-endian, like a C51 uint16_t, so a uint16_t
+ *          array can be passed cast to uint8_t* and read in place (the same
+ *          holds for WriteDgusVp()).
  * @param Addr Starting address of the DGUS register.
  * @param pBuf Pointer to the buffer to store the read data.
  * @param Len16 Number of 16-bit words to read.
  */
 void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16);
 
+/**
+ * @brief Copies words from the NOR flash database into VP memory.
+ * @details Waits until the DGUS core clears the request, for at most
+ *          NOR_FLASH_POLL_MAX polls.
+ * @param NorAddr NOR word address (even).
+ * @param VpAddr VP address (even).
+ * @param Len16 Number of 16-bit words (even).
+ * @return NorStatus NOR_OK, or NOR_TIMEOUT if the core never completed it.
+ */
+NorStatus NorFlashRead(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16);
+
+/**
+ * @brief Copies words from VP memory into the NOR flash database.
+ * @details Waits until the DGUS core clears the request (a flash write takes
+ *          ms), for at most NOR_FLASH_POLL_MAX polls.
+ * @param NorAddr NOR word address (even).
+ * @param VpAddr VP address (even).
+ * @param Len16 Number of 16-bit words (even).
+ * @return NorStatus NOR_OK, or NOR_TIMEOUT if the core never completed it.
+ */
+NorStatus NorFlashWrite(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16);
+
 /**
  * @brief Initializes the CPU and system peripherals.
  */
@@ -34,58 +34,150 @@ SOFTWARE.
 //==============================================================================
 #include "Delay.h" // OK
 #include "WDT.h"
+#include "TimeStamp.h"
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
 /**
- * @var uint32_t DelayMsTick
- * @brief Global tick counter for millisecond delays.
+ * @def DELAY_TICKS_PER_US_Q16
+ * @brief Timer2 counts per microsecond, 16-bit fixed point, rounded up (17.2032 -> 1127429).
+ * @details Taken from FOSC, not the truncated TIME_TICKS_PER_MS. 46875 is
+ *          12000000 / 256, which keeps the preprocessor arithmetic in 32 bits.
  */
-extern uint32_t DelayMsTick;
+#define DELAY_TICKS_PER_US_Q16	(((FOSC / 46875UL) << 8) + ((FOSC % 46875UL) * 256 + 46874UL) / 46875UL)
+
+/**
+ * @def DELAY_US_CHUNK
+ * @brief Longest microsecond span converted at once, keeps us * Q16 in 32 bits.
+ */
+#define DELAY_US_CHUNK			3000UL
+
+/**
+ * @def PCON_IDLE
+ * @brief PCON idle bit: the core stops until the next enabled interrupt.
+ */
+#define PCON_IDLE				0x01
 
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
+/**
+ * @brief Samples the running Timer2 counter without a torn read.
+ * @return uint16_t Timer2 count (T1MS to 0xFFFF).
+ */
+static uint16_t DelayTimer2Read(void)
+{
+    uint8_t h, l;
+    do
+    {
+        h = TH2;
+        l = TL2;
+    } while (h != TH2);
+    return ((uint16_t)h << 8) | l;
+}
 
 /**
  * @brief Delays execution for a specified number of microseconds.
+ * @details Polls the Timer2 counter and adds up the counts it moves, so it
+ *          works with interrupts on or off. Resolution is one Timer2 count
+ *          (12/FOSC, ~58 ns). The count is rounded up, with the fraction
+ *          carried from chunk to chunk, plus one for the partial count at
+ *          the first poll, so the wait is never short. It can be longer by
+ *          that count, the Q16 rounding (under 1 ppm), the entry overhead
+ *          (under 1 us) and an ISR running at its end.
+ *          Polls must be less than 1 ms apart, so ISRs longer than 1 ms make
+ *          it overshoot. Without Timer2 it falls back to an uncalibrated loop.
  * @param us Number of microseconds to delay.
  */
 void SysDelayUs(uint32_t us)
 {
-    uint16_t ui, uj;
-    for (ui = 0; ui < us; ui++)
-        for (uj = 0; uj < 5; uj++);
+    uint32_t chunk, ticks, elapsed = 0;
+    uint32_t frac = 0x1FFFF;    // One count for the partial first one, the rest rounds up
+    uint16_t prev, now, ui, uj;
+
+    if (!TR2)
+    {
+        for (ui = 0; ui < us; ui++)
+            for (uj = 0; uj < 5; uj++);
+        return;
+    }
+    prev = DelayTimer2Read();
+    while (us)
+    {
+        chunk = us > DELAY_US_CHUNK ? DELAY_US_CHUNK : us;
+        us -= chunk;
+        ticks = chunk * DELAY_TICKS_PER_US_Q16 + frac;
+        frac = ticks & 0xFFFF;
+        ticks >>= 16;
+        while (elapsed < ticks)
+        {
+            now = DelayTimer2Read();
+            if (now >= prev) elapsed += now - prev;
+            else elapsed += (uint16_t)(now - prev) - (uint16_t)T1MS; // Reloaded
+            prev = now;
+        }
+        elapsed -= ticks;
+    }
 }
 
 /**
  * @brief Delays execution for a specified number of milliseconds.
+ * @details Waits for at least ms full ticks of the 1 ms Timer2 interrupt,
+ *          idling the CPU between ticks when DELAY_IDLE_ENABLE is set.
+ *          With interrupts off it falls back to SysDelayUs().
  * @param ms Number of milliseconds to delay.
  */
 void SysDelayMs(uint32_t ms)
 {
-    DelayMsTick = ms;
-    while (DelayMsTick) { ; }
+    uint32_t start;
+
+    if (!EA || !ET2 || !TR2)
+    {
+        while (ms--) SysDelayUs(1000);
+        return;
+    }
+    start = TimeNowMs();
+    while (TimeNowMs() - start <= ms)
+    {
+#if DELAY_IDLE_ENABLE
+        PCON |= PCON_IDLE;
+#endif
+    }
 }
 
 /**
  * @brief Delays execution for a specified number of milliseconds with watchdog timer reset.
+ * @details Refreshes the watchdog once per elapsed millisecond. This bypasses
+ *          the task supervisor, so keep it to start-up code.
  * @param ms Number of milliseconds to delay.
  */
 void SysDelayMsWdtReset(uint32_t ms)
 {
-    uint32_t DelayMsTickOld;
+    uint32_t start, now, last;
 
-    DelayMsTick = ms;
-    if (DelayMsTick)
+    if (!EA || !ET2 || !TR2)
     {
-        if (DelayMsTick != DelayMsTickOld)
+        while (ms--)
         {
-            DelayMsTickOld = DelayMsTick;
             WDTRefresh();
+            SysDelayUs(1000);
         }
+        WDTRefresh();
+        return;
     }
+    start = TimeNowMs();
+    last = start;
+    WDTRefresh();
+    do
+    {
+        now = TimeNowMs();
+        if (now != last)
+        {
+            last = now;
+            WDTRefresh();
+        }
+    } while (now - start <= ms);
 }
 
 //==============================================================================
@@ -0,0 +1,297 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SoftTimer.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def SOFT_TIMER_MASK
+ * @brief Slot index mask of one wheel level.
+ */
+#define SOFT_TIMER_MASK			(SOFT_TIMER_WHEEL_SLOTS - 1)
+
+/**
+ * @def SOFT_TIMER_SPAN1
+ * @brief Ticks covered by wheel level 0 (the step of level 1).
+ */
+#define SOFT_TIMER_SPAN1		((uint32_t)SOFT_TIMER_WHEEL_SLOTS)
+
+/**
+ * @def SOFT_TIMER_SPAN2
+ * @brief Ticks covered by wheel levels 0 and 1 (the step of level 2).
+ */
+#define SOFT_TIMER_SPAN2		(SOFT_TIMER_SPAN1 * SOFT_TIMER_WHEEL_SLOTS)
+
+/**
+ * @def SOFT_TIMER_SPAN3
+ * @brief Ticks covered by the whole wheel.
+ */
+#define SOFT_TIMER_SPAN3		(SOFT_TIMER_SPAN2 * SOFT_TIMER_WHEEL_SLOTS)
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief Software timer entry, linked into one wheel slot.
+ */
+typedef struct
+{
+    SoftTimerCallback Callback; ///< Expiry callback, NULL when the entry is free.
+    uint32_t Expire;            ///< Wheel time of the next expiry.
+    uint32_t Period;            ///< Repeat period, 0 for one-shot.
+    uint8_t  Next;              ///< Next entry in the slot.
+    uint8_t  Prev;              ///< Previous entry in the slot.
+    uint8_t  Slot;              ///< Slot the entry is linked into.
+} SoftTimer;
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+/**
+ * @var SoftTimer Timers
+ * @brief Software timer pool.
+ */
+static SoftTimer xdata Timers[SOFT_TIMER_COUNT];
+
+/**
+ * @var uint8_t Wheel
+ * @brief First entry of every slot of every level.
+ */
+static uint8_t xdata Wheel[SOFT_TIMER_WHEEL_LEVELS * SOFT_TIMER_WHEEL_SLOTS];
+
+/**
+ * @var uint32_t WheelNow
+ * @brief Wheel time in ms, advanced by SoftTimerProcess().
+ */
+static uint32_t xdata WheelNow = 0;
+
+/**
+ * @var uint16_t TickPending
+ * @brief Ticks counted by Timer2Isr and not yet processed.
+ * @details 16 bits so a main loop held up for longer than 255 ms does not lose
+ *          wheel time; it saturates only after 65 s. Read and written with EA
+ *          cleared, the ISR can change it between the two bytes.
+ */
+static volatile uint16_t TickPending = 0;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Links a timer into the slot matching its expiry time.
+ * @param Id Timer handle.
+ */
+static void SoftTimerLink(uint8_t Id)
+{
+    SoftTimer xdata* t = &Timers[Id];
+    uint32_t delta = t->Expire - WheelNow;
+    uint8_t slot;
+
+    if (delta < SOFT_TIMER_SPAN1)
+    {
+        slot = (uint8_t)t->Expire & SOFT_TIMER_MASK;
+    }
+    else if (delta < SOFT_TIMER_SPAN2)
+    {
+        slot = SOFT_TIMER_WHEEL_SLOTS + ((uint8_t)(t->Expire >> SOFT_TIMER_WHEEL_BITS) & SOFT_TIMER_MASK);
+    }
+    else if (delta < SOFT_TIMER_SPAN3)
+    {
+        slot = 2 * SOFT_TIMER_WHEEL_SLOTS + ((uint8_t)(t->Expire >> (2 * SOFT_TIMER_WHEEL_BITS)) & SOFT_TIMER_MASK);
+    }
+    else
+    {
+        // Out of range: park in the level 2 slot that turns last and re-sort then.
+        slot = 2 * SOFT_TIMER_WHEEL_SLOTS + ((uint8_t)((WheelNow >> (2 * SOFT_TIMER_WHEEL_BITS)) - 1) & SOFT_TIMER_MASK);
+    }
+
+    t->Slot = slot;
+    t->Prev = SOFT_TIMER_NONE;
+    t->Next = Wheel[slot];
+    if (Wheel[slot] != SOFT_TIMER_NONE) Timers[Wheel[slot]].Prev = Id;
+    Wheel[slot] = Id;
+}
+
+/**
+ * @brief Removes a timer from its slot.
+ * @param Id Timer handle.
+ */
+static void SoftTimerUnlink(uint8_t Id)
+{
+    SoftTimer xdata* t = &Timers[Id];
+
+    if (t->Prev != SOFT_TIMER_NONE) Timers[t->Prev].Next = t->Next;
+    else Wheel[t->Slot] = t->Next;
+    if (t->Next != SOFT_TIMER_NONE) Timers[t->Next].Prev = t->Prev;
+}
+
+/**
+ * @brief Moves every timer of an upper-level slot down the wheel.
+ * @param Slot Slot index.
+ */
+static void SoftTimerCascade(uint8_t Slot)
+{
+    uint8_t id = Wheel[Slot];
+    uint8_t next;
+
+    Wheel[Slot] = SOFT_TIMER_NONE;
+    while (id != SOFT_TIMER_NONE)
+    {
+        next = Timers[id].Next;
+        SoftTimerLink(id);
+        id = next;
+    }
+}
+
+/**
+ * @brief Clears all software timers.
+ */
+void SoftTimerInit(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < SOFT_TIMER_COUNT; i++) Timers[i].Callback = 0;
+    for (i = 0; i < SOFT_TIMER_WHEEL_LEVELS * SOFT_TIMER_WHEEL_SLOTS; i++) Wheel[i] = SOFT_TIMER_NONE;
+    WheelNow = 0;
+    TickPending = 0;
+}
+
+/**
+ * @brief Counts one 1 ms tick. Called from Timer2Isr only.
+ */
+void SoftTimerTick(void)
+{
+    if (TickPending != 0xFFFF) TickPending++;
+}
+
+/**
+ * @brief Advances the wheel by the ticks counted so far and runs expired callbacks.
+ */
+void SoftTimerProcess(void)
+{
+    SoftTimerCallback cb;
+    uint16_t pending;
+    uint8_t slot;
+    uint8_t id;
+
+    for (;;)
+    {
+        EA = 0;
+        pending = TickPending;
+        if (pending) TickPending--;
+        EA = 1;
+        if (pending == 0) break;
+
+        WheelNow++;
+        slot = (uint8_t)WheelNow & SOFT_TIMER_MASK;
+        if (slot == 0)
+        {
+            if (((uint8_t)(WheelNow >> SOFT_TIMER_WHEEL_BITS) & SOFT_TIMER_MASK) == 0)
+            {
+                SoftTimerCascade(2 * SOFT_TIMER_WHEEL_SLOTS + ((uint8_t)(WheelNow >> (2 * SOFT_TIMER_WHEEL_BITS)) & SOFT_TIMER_MASK));
+            }
+            SoftTimerCascade(SOFT_TIMER_WHEEL_SLOTS + ((uint8_t)(WheelNow >> SOFT_TIMER_WHEEL_BITS) & SOFT_TIMER_MASK));
+        }
+
+        // Re-armed and newly started timers never land in the slot being run.
+        while (Wheel[slot] != SOFT_TIMER_NONE)
+        {
+            id = Wheel[slot];
+            SoftTimerUnlink(id);
+            cb = Timers[id].Callback;
+            if (Timers[id].Period)
+            {
+                Timers[id].Expire += Timers[id].Period;
+                SoftTimerLink(id);
+            }
+            else
+            {
+                Timers[id].Callback = 0;
+            }
+            cb();
+        }
+    }
+}
+
+/**
+ * @brief Starts a software timer.
+ * @param Callback Function to call on expiry.
+ * @param DelayMs Time to the first expiry (0 runs on the next tick).
+ * @param PeriodMs Repeat period, 0 for a one-shot timer.
+ * @return uint8_t Timer handle, or SOFT_TIMER_NONE if all timers are in use.
+ */
+uint8_t SoftTimerStart(SoftTimerCallback Callback, uint32_t DelayMs, uint32_t PeriodMs)
+{
+    uint8_t id;
+
+    if (Callback == 0) return SOFT_TIMER_NONE;
+    for (id = 0; id < SOFT_TIMER_COUNT; id++)
+    {
+        if (Timers[id].Callback == 0) break;
+    }
+    if (id == SOFT_TIMER_COUNT) return SOFT_TIMER_NONE;
+
+    if (DelayMs == 0) DelayMs = 1;
+    Timers[id].Callback = Callback;
+    Timers[id].Expire = WheelNow + DelayMs;
+    Timers[id].Period = PeriodMs;
+    SoftTimerLink(id);
+    return id;
+}
+
+/**
+ * @brief Stops a software timer and frees its handle.
+ * @param Id Timer handle from SoftTimerStart().
+ */
+void SoftTimerStop(uint8_t Id)
+{
+    if (Id >= SOFT_TIMER_COUNT || Timers[Id].Callback == 0) return;
+    SoftTimerUnlink(Id);
+    Timers[Id].Callback = 0;
+}
+
+/**
+ * @brief Returns the wheel time in ms (ticks already processed).
+ * @return uint32_t Current wheel time.
+ */
+uint32_t SoftTimerNow(void)
+{
+    return WheelNow;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
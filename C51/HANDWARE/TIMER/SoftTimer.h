@@ -0,0 +1,124 @@
+#ifndef __SOFT_TIMER_H__
+#define __SOFT_TIMER_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def SOFT_TIMER_NONE
+ * @brief Invalid timer handle.
+ */
+#define SOFT_TIMER_NONE			0xFF
+
+/**
+ * @def SOFT_TIMER_WHEEL_BITS
+ * @brief log2 of the slots per wheel level.
+ * @details Three levels of 32 slots cover 1 ms, 32 ms and 1024 ms steps,
+ *          i.e. delays up to 32767 ms go straight into a slot. Longer
+ *          delays are parked in the last level and re-sorted as it turns.
+ */
+#define SOFT_TIMER_WHEEL_BITS	5
+
+/**
+ * @def SOFT_TIMER_WHEEL_SLOTS
+ * @brief Slots per wheel level.
+ */
+#define SOFT_TIMER_WHEEL_SLOTS	(1 << SOFT_TIMER_WHEEL_BITS)
+
+/**
+ * @def SOFT_TIMER_WHEEL_LEVELS
+ * @brief Number of wheel levels.
+ */
+#define SOFT_TIMER_WHEEL_LEVELS	3
+
+/**
+ * @brief Software timer callback.
+ * @details Called from SoftTimerProcess() in the main loop, never from an ISR.
+ *          Callbacks are reached through a function pointer, which Keil's
+ *          overlay analysis cannot follow: each one is listed in the linker
+ *          OVERLAY directive of template.uvproj as "SoftTimerProcess ! callback"
+ *          plus "starter ~ callback" for the function passing it to
+ *          SoftTimerStart(). Add new callbacks there.
+ */
+typedef void (*SoftTimerCallback)(void);
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears all software timers.
+ */
+void SoftTimerInit(void);
+
+/**
+ * @brief Counts one 1 ms tick. Called from Timer2Isr only.
+ */
+void SoftTimerTick(void);
+
+/**
+ * @brief Advances the wheel by the ticks counted so far and runs expired callbacks.
+ * @details Call from the main loop. Each tick costs one slot visit plus an
+ *          occasional cascade of one upper-level slot.
+ */
+void SoftTimerProcess(void);
+
+/**
+ * @brief Starts a software timer.
+ * @param Callback Function to call on expiry.
+ * @param DelayMs Time to the first expiry (0 runs on the next tick).
+ * @param PeriodMs Repeat period, 0 for a one-shot timer.
+ * @return uint8_t Timer handle, or SOFT_TIMER_NONE if all timers are in use.
+ */
+uint8_t SoftTimerStart(SoftTimerCallback Callback, uint32_t DelayMs, uint32_t PeriodMs);
+
+/**
+ * @brief Stops a software timer and frees its handle.
+ * @param Id Timer handle from SoftTimerStart().
+ */
+void SoftTimerStop(uint8_t Id);
+
+/**
+ * @brief Returns the wheel time in ms (ticks already processed).
+ * @return uint32_t Current wheel time.
+ */
+uint32_t SoftTimerNow(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -59,6 +59,7 @@ xdata uint32_t Counter = 1000;
 //==============================================================================
 //---------------------------------- INIT---------------------------------------
 //==============================================================================
+#if TIMER_0_ENABLE
 /**
  * @brief Initializes Timer0 with a 1ms period in 16-bit mode.
  */
@@ -70,7 +71,9 @@ void InitTimer0(void)
     ET0 = 1; // Enable Timer0 interrupt
     TR0 = 1; // Start Timer0
 }
+#endif
 
+#if TIMER_1_ENABLE
 /**
  * @brief Initializes Timer1 with a 1ms period in 16-bit mode.
  */
@@ -82,6 +85,7 @@ void InitTimer1(void)
     ET1 = 1; // Enable Timer1 interrupt
     TR1 = 1; // Start Timer1
 }
+#endif
 
 /**
  * @brief Initializes Timer2 with a 1ms period.
@@ -89,8 +93,8 @@ void InitTimer1(void)
 void InitTimer2(void)
 {
     T2CON = 0x70; // Configure Timer2
-    TH2 = 0x00;   // Initialize counter high byte
-    TL2 = 0x00;   // Initialize counter low byte
+    TH2 = (uint8_t)(T2_PERIOD_1MS >> 8); // First period is 1ms as well
+    TL2 = (uint8_t)T2_PERIOD_1MS;       // so TimeStamp sub-ms counts stay in range
     TRL2H = (uint8_t)(T2_PERIOD_1MS >> 8); // High byte of 1ms period
     TRL2L = (uint8_t)T2_PERIOD_1MS;       // Low byte of 1ms period
     IEN0 |= 0x20; // Enable Timer2 interrupt
@@ -104,10 +108,10 @@ void InitTimer2(void)
 void TimerInit(void)
 {
     EA = 0; // Disable global interrupts
-#ifdef TIMER_0_ENABLE
+#if TIMER_0_ENABLE
     InitTimer0();
 #endif
-#ifdef TIMER_1_ENABLE
+#if TIMER_1_ENABLE
     InitTimer1();
 #endif
     InitTimer2();
@@ -0,0 +1,179 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "TimeStamp.h"
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/**
+ * @var uint32_t SysTimCnt
+ * @brief Milliseconds since TimeInit().
+ */
+xdata uint32_t SysTimCnt = 0;
+
+/**
+ * @var uint32_t Uptime
+ * @brief Seconds since TimeInit().
+ */
+xdata uint32_t Uptime = 0;
+
+/**
+ * @var uint32_t TimeTicks
+ * @brief Timer2 counts at the start of the current millisecond.
+ */
+xdata uint32_t TimeTicks = 0;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears the time counters. Call before Timer2 is started.
+ */
+void TimeInit(void)
+{
+    SysTimCnt = 0;
+    Uptime = 0;
+    TimeTicks = 0;
+}
+
+/**
+ * @brief Milliseconds since TimeInit(), read atomically.
+ * @return uint32_t Milliseconds.
+ */
+uint32_t TimeNowMs(void)
+{
+    uint32_t ms;
+    bit ea = EA;
+
+    EA = 0;
+    ms = SysTimCnt;
+    EA = ea;
+    return ms;
+}
+
+/**
+ * @brief Seconds since TimeInit(), read atomically.
+ * @return uint32_t Seconds.
+ */
+uint32_t TimeUptime(void)
+{
+    uint32_t s;
+    bit ea = EA;
+
+    EA = 0;
+    s = Uptime;
+    EA = ea;
+    return s;
+}
+
+/**
+ * @brief High-resolution timestamp in Timer2 counts (TIME_TICKS_PER_MS per ms).
+ * @return uint32_t Ticks, wrapping after about 249 s.
+ */
+uint32_t TimeNowTicks(void)
+{
+    uint32_t t;
+    bit ea = EA;
+
+    EA = 0;
+    TIME_NOW_TICKS_ISR(t);
+    EA = ea;
+    return t;
+}
+
+/**
+ * @brief Microsecond timestamp.
+ * @return uint32_t Microseconds, wrapping after about 71 minutes.
+ */
+uint32_t TimeNowUs(void)
+{
+    uint32_t ms;
+    uint16_t sub;
+    bit ea = EA;
+
+    EA = 0;
+    TIME_SAMPLE_ISR(SysTimCnt, 1, ms, sub);
+    EA = ea;
+    return ms * 1000 + (uint16_t)(((uint32_t)sub * TIME_US_SCALE) >> 16);
+}
+
+/**
+ * @brief Ticks elapsed since an earlier TimeNowTicks() value.
+ * @param Since Earlier timestamp.
+ * @return uint32_t Elapsed ticks.
+ */
+uint32_t TimeElapsedTicks(uint32_t Since)
+{
+    return TimeNowTicks() - Since;
+}
+
+/**
+ * @brief Microseconds elapsed since an earlier TimeNowUs() value.
+ * @param Since Earlier timestamp.
+ * @return uint32_t Elapsed microseconds.
+ */
+uint32_t TimeElapsedUs(uint32_t Since)
+{
+    return TimeNowUs() - Since;
+}
+
+/**
+ * @brief Converts a tick interval to microseconds (for reporting, uses a division).
+ * @param Ticks Interval in Timer2 counts.
+ * @return uint32_t Interval in microseconds.
+ */
+uint32_t TimeTicksToUs(uint32_t Ticks)
+{
+    return (Ticks / TIME_TICKS_PER_MS) * 1000
+         + (uint16_t)(((uint32_t)(uint16_t)(Ticks % TIME_TICKS_PER_MS) * TIME_US_SCALE) >> 16);
+}
+
+#if BENCH_ANY_ENABLE
+/**
+ * @brief Writes the results of a microbenchmark, then TIME_TICKS_PER_MS, to its slot.
+ * @param Vp Slot, one of the *_BENCH_VP.
+ * @param Result Count results and one more word for TIME_TICKS_PER_MS.
+ * @param Count Number of results.
+ */
+void BenchReport(uint16_t Vp, uint16_t *Result, uint8_t Count)
+{
+    Result[Count] = TIME_TICKS_PER_MS;
+    WriteDgusVp(Vp, (uint8_t*)Result, Count + 1);
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
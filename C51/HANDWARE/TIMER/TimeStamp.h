@@ -0,0 +1,212 @@
+#ifndef __TIME_STAMP_H__
+#define __TIME_STAMP_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def TIME_TICKS_PER_MS
+ * @brief Timer2 counts per millisecond, the unit of the tick timestamps.
+ * @details One tick is 12/FOSC, about 58 ns; a 32-bit tick value wraps after
+ *          about 249 s, so tick intervals must stay below that.
+ */
+#define TIME_TICKS_PER_MS		((uint16_t)(FOSC / 12 / 1000))
+
+/**
+ * @def TIME_US_SCALE
+ * @brief Ticks to microseconds as a 16-bit fraction: 65536 * 1000 / TIME_TICKS_PER_MS.
+ */
+#define TIME_US_SCALE			((uint16_t)(65536UL * 1000 / (FOSC / 12 / 1000)))
+
+/**
+ * @def TIME_SAMPLE_ISR
+ * @brief Samples the millisecond base and the Timer2 count into the millisecond.
+ * @details Only with interrupts off or inside an ISR. TH2 is re-read to avoid
+ *          a torn 16-bit read, and an overflow that is pending but not yet
+ *          counted by Timer2Isr moves the sample to the next millisecond,
+ *          so samples never run backwards.
+ * @param base Millisecond-based counter to sample (SysTimCnt or TimeTicks).
+ * @param step Amount Timer2Isr adds to base per millisecond.
+ * @param t Receives base (corrected for a pending overflow).
+ * @param sub Receives Timer2 counts into the millisecond.
+ */
+#define TIME_SAMPLE_ISR(base, step, t, sub) \
+{ \
+    uint8_t h, l; \
+    do \
+    { \
+        h = TH2; \
+        l = TL2; \
+    } while (h != TH2); \
+    (sub) = (((uint16_t)h << 8) | l) - (uint16_t)T1MS; \
+    (t) = (base); \
+    if (TF2 && (sub) < TIME_TICKS_PER_MS / 2) (t) += (step); \
+}
+
+/**
+ * @def TIME_NOW_TICKS_ISR
+ * @brief Tick timestamp for use inside ISRs or with interrupts off.
+ * @param t uint32_t receiving the timestamp.
+ */
+#define TIME_NOW_TICKS_ISR(t) \
+{ \
+    uint16_t sub_; \
+    TIME_SAMPLE_ISR(TimeTicks, TIME_TICKS_PER_MS, t, sub_); \
+    (t) += sub_; \
+}
+
+/**
+ * @def BENCH_ANY_ENABLE
+ * @brief 1 if any start-up microbenchmark is enabled (BenchReport() is built).
+ */
+#define BENCH_ANY_ENABLE		(CRC_BENCH_ENABLE || ADC_BENCH_ENABLE || PWM_BENCH_ENABLE || GPIO_BENCH_ENABLE \
+								|| PULSE_BENCH_ENABLE || SPI_BENCH_ENABLE || I2C_BENCH_ENABLE)
+
+// Result slot of each start-up microbenchmark, from BENCH_VP (GlobalConfig.h).
+#define CRC_BENCH_VP			(BENCH_VP + 0x00)	///< Crc16Bench(), 3 words.
+#define ADC_BENCH_VP			(BENCH_VP + 0x08)	///< AdcBench(), 3 words.
+#define PWM_BENCH_VP			(BENCH_VP + 0x0C)	///< PwmBench(), 3 words.
+#define GPIO_BENCH_VP			(BENCH_VP + 0x10)	///< GpioBench(), 4 words.
+#define PULSE_BENCH_VP			(BENCH_VP + 0x14)	///< PulseBench(), 4 words.
+#define SPI_BENCH_VP			(BENCH_VP + 0x18)	///< SpiBench(), 6 words.
+#define I2C_BENCH_VP			(BENCH_VP + 0x1E)	///< I2cBench(), 3 words.
+
+/**
+ * @def BENCH_RUNS_LOG2
+ * @brief BENCH_TIME() averages over 1 << BENCH_RUNS_LOG2 runs.
+ */
+#define BENCH_RUNS_LOG2			6
+
+/**
+ * @def BENCH_TIME
+ * @brief Times a statement and stores the rounded ticks per run.
+ * @details Timer2 must be running; the loop overhead is included.
+ * @param Result uint16_t receiving ticks per run.
+ * @param Run uint8_t loop counter, 0 to (1 << BENCH_RUNS_LOG2) - 1, usable in Body.
+ * @param Body Statement to time.
+ */
+#define BENCH_TIME(Result, Run, Body) \
+{ \
+    uint32_t start_ = TimeNowTicks(); \
+    for (Run = 0; Run < (1 << BENCH_RUNS_LOG2); Run++) \
+    { \
+        Body; \
+    } \
+    start_ = TimeElapsedTicks(start_); \
+    (Result) = (uint16_t)((start_ + (1 << (BENCH_RUNS_LOG2 - 1))) >> BENCH_RUNS_LOG2); \
+}
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Milliseconds since TimeInit(), counted by Timer2Isr. */
+extern xdata uint32_t SysTimCnt;
+
+/** @brief Seconds since TimeInit(), counted by Timer2Isr. */
+extern xdata uint32_t Uptime;
+
+/** @brief Timer2 counts at the start of the current millisecond. */
+extern xdata uint32_t TimeTicks;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears the time counters. Call before Timer2 is started.
+ */
+void TimeInit(void);
+
+/**
+ * @brief Milliseconds since TimeInit(), read atomically.
+ * @return uint32_t Milliseconds.
+ */
+uint32_t TimeNowMs(void);
+
+/**
+ * @brief Seconds since TimeInit(), read atomically.
+ * @return uint32_t Seconds.
+ */
+uint32_t TimeUptime(void);
+
+/**
+ * @brief High-resolution timestamp in Timer2 counts (TIME_TICKS_PER_MS per ms).
+ * @return uint32_t Ticks, wrapping after about 249 s.
+ */
+uint32_t TimeNowTicks(void);
+
+/**
+ * @brief Microsecond timestamp.
+ * @return uint32_t Microseconds, wrapping after about 71 minutes.
+ */
+uint32_t TimeNowUs(void);
+
+/**
+ * @brief Ticks elapsed since an earlier TimeNowTicks() value.
+ * @param Since Earlier timestamp.
+ * @return uint32_t Elapsed ticks.
+ */
+uint32_t TimeElapsedTicks(uint32_t Since);
+
+/**
+ * @brief Microseconds elapsed since an earlier TimeNowUs() value.
+ * @param Since Earlier timestamp.
+ * @return uint32_t Elapsed microseconds.
+ */
+uint32_t TimeElapsedUs(uint32_t Since);
+
+/**
+ * @brief Converts a tick interval to microseconds (for reporting, uses a division).
+ * @param Ticks Interval in Timer2 counts.
+ * @return uint32_t Interval in microseconds.
+ */
+uint32_t TimeTicksToUs(uint32_t Ticks);
+
+#if BENCH_ANY_ENABLE
+/**
+ * @brief Writes the results of a microbenchmark, then TIME_TICKS_PER_MS, to its slot.
+ * @param Vp Slot, one of the *_BENCH_VP above.
+ * @param Result Count results and one more word for TIME_TICKS_PER_MS.
+ * @param Count Number of results.
+ */
+void BenchReport(uint16_t Vp, uint16_t *Result, uint8_t Count);
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
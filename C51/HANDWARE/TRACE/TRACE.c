@@ -0,0 +1,150 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "TRACE.h"
+#include "UART.h"
+
+#if TRACE_ENABLE
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/**
+ * @var TraceEntry TraceRing
+ * @brief Trace ring, the newest TRACE_DEPTH events.
+ */
+TraceEntry xdata TraceRing[TRACE_DEPTH];
+
+/**
+ * @var uint16_t TraceSeq
+ * @brief Number of events recorded.
+ */
+uint16_t xdata TraceSeq = 0;
+
+/**
+ * @var uint8_t TracePaused
+ * @brief Recording is suspended while non-zero.
+ */
+uint8_t data TracePaused = 0;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Clears the trace ring and resumes recording.
+ */
+void TraceInit(void)
+{
+    EA = 0;
+    TraceSeq = 0;
+    TracePaused = 0;
+    EA = 1;
+}
+
+/**
+ * @brief Records an event from the main loop.
+ * @param Event Event ID.
+ * @param Arg 16-bit argument.
+ */
+void TraceEvent(uint8_t Event, uint16_t Arg)
+{
+    bit ea = EA;
+
+    EA = 0;
+    TRACE_ISR(Event, Arg);
+    EA = ea;
+}
+
+/**
+ * @brief Sends the ring, oldest entry first, as TRACE_CMD frames.
+ * @param uart_num UART identifier (2, 3, 4, or 5).
+ * @param crc_ck Append CRC16 to each frame.
+ * @param flags TRACE_FLAG_CLEAR to empty the ring afterwards.
+ */
+void TraceDump(uint8_t uart_num, bit crc_ck, uint8_t flags)
+{
+    uint8_t xdata frame[8 + TRACE_DUMP_ENTRIES * TRACE_ENTRY_SIZE + 2];
+    TraceEntry xdata* e;
+    uint8_t* p;
+    uint16_t seq, count;
+    uint8_t i, n, len;
+
+    TracePaused = 1;
+    count = TraceSeq < TRACE_DEPTH ? TraceSeq : TRACE_DEPTH;
+    seq = TraceSeq - count;
+    do
+    {
+        n = count > TRACE_DUMP_ENTRIES ? TRACE_DUMP_ENTRIES : (uint8_t)count;
+        count -= n;
+        frame[0] = DTHD1;
+        frame[1] = DTHD2;
+        frame[3] = TRACE_CMD;
+        frame[4] = (count == 0);
+        frame[5] = (uint8_t)(seq >> 8);
+        frame[6] = (uint8_t)seq;
+        frame[7] = n;
+        p = &frame[8];
+        for (i = 0; i < n; i++, seq++)
+        {
+            e = &TraceRing[(uint8_t)seq & (TRACE_DEPTH - 1)];
+            *p++ = e->Event;
+            *p++ = (uint8_t)(e->Arg >> 8);
+            *p++ = (uint8_t)e->Arg;
+            *p++ = (uint8_t)(e->Ticks >> 24);
+            *p++ = (uint8_t)(e->Ticks >> 16);
+            *p++ = (uint8_t)(e->Ticks >> 8);
+            *p++ = (uint8_t)e->Ticks;
+        }
+        len = 5 + n * TRACE_ENTRY_SIZE;
+        if (crc_ck)
+        {
+            frame[2] = len + 2;
+            UartSendFrameCrc(uart_num, frame);
+        }
+        else
+        {
+            frame[2] = len;
+            UartSendStr(uart_num, frame, len + 3);
+        }
+    } while (count);
+
+    EA = 0;
+    if (flags & TRACE_FLAG_CLEAR) TraceSeq = 0;
+    TracePaused = 0;
+    EA = 1;
+}
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
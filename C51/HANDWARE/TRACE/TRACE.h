@@ -0,0 +1,203 @@
+#ifndef __TRACE_H__
+#define __TRACE_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+#include "TimeStamp.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def TRACE_CMD
+ * @brief UART command code of the trace dump request.
+ * @details Request: 5A A5 04 8F 00 FLAGS 00 (LEN 06 plus CRC when enabled),
+ *          FLAGS bit 0 clears the ring after the dump. The receive parser
+ *          completes a frame only after the byte following the VP address,
+ *          hence the padding byte. Reply: one or more frames
+ *          5A A5 LEN 8F LAST SEQ_H SEQ_L N followed by N entries of
+ *          EVENT ARG_H ARG_L TICKS(4, big-endian). LAST is 1 on the final frame.
+ */
+#define TRACE_CMD				0x8F
+
+/**
+ * @def TRACE_REQ_LEN
+ * @brief LEN byte of a dump request without CRC (2 more with CRC).
+ */
+#define TRACE_REQ_LEN			4
+
+/**
+ * @def TRACE_ENTRY_SIZE
+ * @brief Bytes per entry in a dump frame.
+ */
+#define TRACE_ENTRY_SIZE		7
+
+/**
+ * @def TRACE_DUMP_ENTRIES
+ * @brief Entries per dump frame.
+ */
+#define TRACE_DUMP_ENTRIES		32
+
+/**
+ * @def TRACE_FLAG_CLEAR
+ * @brief Request flag: clear the ring after the dump.
+ */
+#define TRACE_FLAG_CLEAR		0x01
+
+// Event IDs. Codes below TRACE_EV_INSTANT come in begin/end pairs, the
+// end code being begin + 1; a decoder pairs an end with the last open begin.
+#define TRACE_EV_ISR_ENTER		0x02	///< ISR entry, arg = interrupt number.
+#define TRACE_EV_ISR_EXIT		0x03	///< ISR exit, arg = interrupt number.
+#define TRACE_EV_TASK_BEGIN		0x04	///< Scheduler task start, arg = task ID.
+#define TRACE_EV_TASK_END		0x05	///< Scheduler task end, arg = task ID.
+#define TRACE_EV_DGUS_READ		0x06	///< DGUS read start, arg = VP address.
+#define TRACE_EV_DGUS_READ_END	0x07	///< DGUS read done, arg = 0.
+#define TRACE_EV_DGUS_WRITE		0x08	///< DGUS write start, arg = VP address.
+#define TRACE_EV_DGUS_WRITE_END	0x09	///< DGUS write done, arg = 0.
+#define TRACE_EV_INSTANT		0x10
+#define TRACE_EV_FRAME_OK		0x10	///< Frame accepted, arg = UART << 8 | command.
+#define TRACE_EV_FRAME_BAD		0x11	///< Frame rejected by CRC, arg = UART << 8 | command.
+#define TRACE_EV_FRAME_DROP		0x12	///< Parser resynced, arg = UART << 8 | byte.
+#define TRACE_EV_PAGE			0x13	///< Page change, arg = page ID.
+#define TRACE_EV_INIT			0x14	///< Peripheral init done, arg = TRACE_INIT_x << 8 | result.
+#define TRACE_EV_USER			0x80	///< First application-defined event.
+
+// Peripheral IDs of TRACE_EV_INIT.
+#define TRACE_INIT_PWM0			0x00	///< PWM0, result = PwmInitState.
+#define TRACE_INIT_DAC			0x01	///< DAC (PWM1), result = PwmInitState.
+
+#if TRACE_ENABLE
+/**
+ * @def TRACE_ISR
+ * @brief Records an event from an ISR or with interrupts off.
+ * @param ev Event ID.
+ * @param arg 16-bit argument.
+ */
+#define TRACE_ISR(ev, arg) \
+{ \
+    if (!TracePaused) \
+    { \
+        TraceEntry xdata* e_ = &TraceRing[(uint8_t)TraceSeq & (TRACE_DEPTH - 1)]; \
+        TIME_NOW_TICKS_ISR(e_->Ticks); \
+        e_->Event = (ev); \
+        e_->Arg = (arg); \
+        if (++TraceSeq == 0) TraceSeq = TRACE_DEPTH; \
+    } \
+}
+#else
+#define TRACE_ISR(ev, arg)
+#endif
+
+#if TRACE_ENABLE && TRACE_ISR_ENABLE
+/**
+ * @def TRACE_ISR_ENTER
+ * @brief Records ISR entry when TRACE_ISR_ENABLE is set.
+ * @param Irq Interrupt number.
+ */
+#define TRACE_ISR_ENTER(Irq)	TRACE_ISR(TRACE_EV_ISR_ENTER, Irq)
+
+/**
+ * @def TRACE_ISR_EXIT
+ * @brief Records ISR exit when TRACE_ISR_ENABLE is set.
+ * @param Irq Interrupt number.
+ */
+#define TRACE_ISR_EXIT(Irq)		TRACE_ISR(TRACE_EV_ISR_EXIT, Irq)
+#else
+#define TRACE_ISR_ENTER(Irq)
+#define TRACE_ISR_EXIT(Irq)
+#endif
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief One trace record.
+ */
+typedef struct
+{
+    uint8_t  Event;            ///< Event ID.
+    uint16_t Arg;              ///< Event argument.
+    uint32_t Ticks;            ///< TimeNowTicks() at the event.
+} TraceEntry;
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Trace ring, the newest TRACE_DEPTH events. */
+extern TraceEntry xdata TraceRing[TRACE_DEPTH];
+
+/**
+ * @brief Number of events recorded, the next slot is its low bits.
+ * @details Wraps to TRACE_DEPTH instead of 0 so a full ring stays full.
+ */
+extern uint16_t xdata TraceSeq;
+
+/** @brief Recording is suspended while non-zero (during a dump). */
+extern uint8_t data TracePaused;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+#if TRACE_ENABLE
+/**
+ * @brief Clears the trace ring and resumes recording.
+ */
+void TraceInit(void);
+
+/**
+ * @brief Records an event from the main loop.
+ * @param Event Event ID.
+ * @param Arg 16-bit argument.
+ */
+void TraceEvent(uint8_t Event, uint16_t Arg);
+
+/**
+ * @brief Sends the ring, oldest entry first, as TRACE_CMD frames.
+ * @details Recording pauses for the dump; the TX buffer blocks, so this
+ *          takes as long as the bytes need on the wire.
+ * @param uart_num UART identifier (2, 3, 4, or 5).
+ * @param crc_ck Append CRC16 to each frame.
+ * @param flags TRACE_FLAG_CLEAR to empty the ring afterwards.
+ */
+void TraceDump(uint8_t uart_num, bit crc_ck, uint8_t flags);
+#else
+#define TraceInit()
+#define TraceEvent(Event, Arg)
+#endif
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -29,9 +29,13 @@ SOFTWARE.
 @endverbatim
 */
 #include "CRC16.h"
+#if CRC_BENCH_ENABLE
+#include "TimeStamp.h"
+#endif
 
+#if CRC16_MODE == CRC16_MODE_TABLE
 /** @brief High byte CRC16 lookup table. */
-const uint8_t crctablehi[] = {
+const uint8_t code crctablehi[] = {
     0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81,
     0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0,
     0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01,
@@ -53,7 +57,7 @@ const uint8_t crctablehi[] = {
 };
 
 /** @brief Low byte CRC16 lookup table. */
-const uint8_t crctablelo[] = {
+const uint8_t code crctablelo[] = {
     0x00, 0xC0, 0xC1, 0x01, 0xC3, 0x03, 0x02, 0xC2, 0xC6, 0x06, 0x07, 0xC7, 0x05, 0xC5, 0xC4,
     0x04, 0xCC, 0x0C, 0x0D, 0xCD, 0x0F, 0xCF, 0xCE, 0x0E, 0x0A, 0xCA, 0xCB, 0x0B, 0xC9, 0x09,
     0x08, 0xC8, 0xD8, 0x18, 0x19, 0xD9, 0x1B, 0xDB, 0xDA, 0x1A, 0x1E, 0xDE, 0xDF, 0x1F, 0xDD,
@@ -75,15 +79,16 @@ const uint8_t crctablelo[] = {
 };
 
 /**
- * @brief Calculates CRC16 for a data buffer using a lookup table.
+ * @brief Continues a running CRC16 over a data buffer.
+ * @param crc Running CRC (CRC16_INIT for a new block).
  * @param ptr Pointer to the data buffer.
  * @param len Length of the data buffer.
- * @return The calculated CRC16 value.
+ * @return The updated running CRC16 value.
  */
-uint16_t Crc16Table(uint8_t *ptr, uint16_t len)
+uint16_t Crc16Update(uint16_t crc, uint8_t *ptr, uint16_t len)
 {
-    uint8_t crchi = 0xFF;
-    uint8_t crclo = 0xFF;
+    uint8_t crchi = (uint8_t)(crc >> 8);
+    uint8_t crclo = (uint8_t)crc;
     uint16_t index;
     while (len--)
     {
@@ -92,4 +97,70 @@ uint16_t Crc16Table(uint8_t *ptr, uint16_t len)
         crchi = crctablelo[index];
     }
     return (crchi << 8 | crclo);
-}
\ No newline at end of file
+}
+
+#else
+#if CRC16_MODE == CRC16_MODE_NIBBLE
+/** @brief CRC16 lookup table for one 4-bit step. */
+const uint16_t code crctablenibble[16] = {
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+};
+#endif
+
+/**
+ * @brief Continues a running CRC16 over a data buffer with CRC16_UPDATE.
+ * @param crc Running CRC (CRC16_INIT for a new block).
+ * @param ptr Pointer to the data buffer.
+ * @param len Length of the data buffer.
+ * @return The updated running CRC16 value.
+ */
+uint16_t Crc16Update(uint16_t crc, uint8_t *ptr, uint16_t len)
+{
+    uint8_t idx;
+    while (len--)
+    {
+        CRC16_UPDATE(crc, idx, *ptr++);
+    }
+    return crc;
+}
+#endif
+
+/**
+ * @brief Calculates CRC16 for a data buffer.
+ * @param ptr Pointer to the data buffer.
+ * @param len Length of the data buffer.
+ * @return The calculated CRC16 value.
+ */
+uint16_t Crc16Table(uint8_t *ptr, uint16_t len)
+{
+    return Crc16Update(CRC16_INIT, ptr, len);
+}
+
+#if CRC_BENCH_ENABLE
+/**
+ * @brief Measures the streaming and the block CRC16 paths on the target.
+ */
+void Crc16Bench(void)
+{
+    uint8_t xdata buf[256];
+    uint16_t result[3];
+    uint32_t start;
+    uint16_t i;
+    uint16_t crc;
+    uint8_t idx;
+
+    for (i = 0; i < 256; i++) buf[i] = (uint8_t)i;
+
+    crc = CRC16_INIT;
+    start = TimeNowTicks();
+    for (i = 0; i < 256; i++) CRC16_UPDATE(crc, idx, buf[i]);
+    result[0] = (uint16_t)TimeElapsedTicks(start);
+
+    start = TimeNowTicks();
+    crc = Crc16Table(buf, 256);
+    result[1] = (uint16_t)TimeElapsedTicks(start);
+
+    BenchReport(CRC_BENCH_VP, result, 2);
+}
+#endif
@@ -40,6 +40,98 @@ SOFTWARE.
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
+// Cost of one CRC16_UPDATE step per CRC16_MODE. Table bytes are exact. The
+// 8051 columns are hand counts of the step with the CRC in registers: inline
+// code bytes and 12-clock machine cycles per byte. The host column is
+// TOOLS/CRC_BENCH (x86, -O2). Crc16Bench() measures the selected mode on the
+// T5L itself.
+//
+//   Mode        Table bytes   Code bytes   8051 cycles/B   Host cycles/B
+//   0 TABLE         512           14             14              7.3
+//   1 NIBBLE         32          ~65           ~110             10.9
+//   2 BITWISE         0          ~45           ~155             21.8
+
+/**
+ * @def CRC16_MODE_TABLE
+ * @brief CRC16_MODE value: 512-byte table in CODE.
+ */
+#define CRC16_MODE_TABLE		0
+
+/**
+ * @def CRC16_MODE_NIBBLE
+ * @brief CRC16_MODE value: 32-byte nibble table in CODE.
+ */
+#define CRC16_MODE_NIBBLE		1
+
+/**
+ * @def CRC16_MODE_BITWISE
+ * @brief CRC16_MODE value: no table.
+ */
+#define CRC16_MODE_BITWISE		2
+
+/**
+ * @def CRC16_POLY
+ * @brief Reflected Modbus polynomial.
+ */
+#define CRC16_POLY				0xA001
+
+/**
+ * @def CRC16_INIT
+ * @brief Initial value of a running CRC16 (Modbus).
+ */
+#define CRC16_INIT				0xFFFF
+
+/**
+ * @def CRC16_UPDATE
+ * @brief Feeds one byte into a running CRC16.
+ * @details Inline form of one Crc16Table() step for use in interrupt routines,
+ *          where a function call would be shared between ISR and main loop.
+ *          Running the CRC over a frame including its CRC bytes (low byte
+ *          first) leaves 0, so a frame is checked by comparing the result to 0.
+ * @param crc uint16_t running CRC.
+ * @param idx uint8_t scratch variable.
+ * @param c Byte to add.
+ */
+#if CRC16_MODE == CRC16_MODE_TABLE
+#define CRC16_UPDATE(crc, idx, c) \
+{ \
+    idx = (uint8_t)(crc) ^ (uint8_t)(c); \
+    crc = ((uint16_t)crctablelo[idx] << 8) | (uint8_t)((uint8_t)((crc) >> 8) ^ crctablehi[idx]); \
+}
+#elif CRC16_MODE == CRC16_MODE_NIBBLE
+#define CRC16_UPDATE(crc, idx, c) \
+{ \
+    crc ^= (uint8_t)(c); \
+    idx = (uint8_t)(crc) & 0x0F; \
+    crc = ((crc) >> 4) ^ crctablenibble[idx]; \
+    idx = (uint8_t)(crc) & 0x0F; \
+    crc = ((crc) >> 4) ^ crctablenibble[idx]; \
+}
+#else
+#define CRC16_UPDATE(crc, idx, c) \
+{ \
+    crc ^= (uint8_t)(c); \
+    for (idx = 0; idx < 8; idx++) \
+    { \
+        if ((crc) & 0x0001) crc = ((crc) >> 1) ^ CRC16_POLY; \
+        else crc >>= 1; \
+    } \
+}
+#endif
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+#if CRC16_MODE == CRC16_MODE_TABLE
+/** @brief High byte CRC16 lookup table. */
+extern const uint8_t code crctablehi[];
+
+/** @brief Low byte CRC16 lookup table. */
+extern const uint8_t code crctablelo[];
+#elif CRC16_MODE == CRC16_MODE_NIBBLE
+/** @brief CRC16 lookup table for one 4-bit step. */
+extern const uint16_t code crctablenibble[];
+#endif
 
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
@@ -53,6 +145,27 @@ SOFTWARE.
  */
 uint16_t Crc16Table(uint8_t *ptr, uint16_t len);
 
+/**
+ * @brief Continues a running CRC16 over a data buffer.
+ * @param crc Running CRC (CRC16_INIT for a new block).
+ * @param ptr Pointer to the data buffer.
+ * @param len Length of the data buffer.
+ * @return The updated running CRC16 value.
+ */
+uint16_t Crc16Update(uint16_t crc, uint8_t *ptr, uint16_t len);
+
+#if CRC_BENCH_ENABLE
+/**
+ * @brief Measures the streaming and the block CRC16 paths on the target.
+ * @details Results go to CRC_BENCH_VP in Timer2 counts (FOSC/12):
+ *          [0] 256 bytes through CRC16_UPDATE (the added RX ISR cost),
+ *          [1] 256 bytes through Crc16Table() (the saved main-loop cost),
+ *          [2] Timer2 counts per millisecond.
+ *          Timer2 must be running.
+ */
+void Crc16Bench(void);
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
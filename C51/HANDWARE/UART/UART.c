@@ -32,7 +32,77 @@ SOFTWARE.
 //==============================================================================
 //---------------------------------Includes-------------------------------------
 //==============================================================================
-#include "Uart.h"
+#include "UART.h"
+#include "SCHEDULER.h"
+#include "TRACE.h"
+#include "DIAG.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def UART_FRAME_CMD
+ * @brief Command codes parsed as address/data frames.
+ * @param c Command byte.
+ */
+#if TRACE_ENABLE
+#define UART_FRAME_CMD(c)	((c) == 0x82 || (c) == 0x83 || (c) == TRACE_CMD)
+#else
+#define UART_FRAME_CMD(c)	((c) == 0x82 || (c) == 0x83)
+#endif
+
+/**
+ * @def UART_RX_CRC_TRACK
+ * @brief Follows the frame layout in the RX ISR and runs CRC16 over each frame.
+ * @details Mirrors the header/length/command checks of UartHandleFrame() so
+ *          both see the same frames. When a frame ends, its end index in the
+ *          RX ring and the CRC verdict are queued for UartRxCrcVerdict().
+ *          Must be used after RxWrite has been advanced past the byte.
+ * @param uart Uartx_Define object.
+ * @param c Received byte.
+ */
+#define UART_RX_CRC_TRACK(uart, c) \
+{ \
+    uint8_t idx, dat = (c); \
+    if ((uart).RxCrcState == UART_REV_GETBODY) \
+    { \
+        CRC16_UPDATE((uart).RxCrc, idx, dat); \
+        if (--(uart).RxCrcLeft == 0) \
+        { \
+            (uart).RxCrcEnd[(uart).RxCrcWrite] = (uart).RxWrite; \
+            (uart).RxCrcOk[(uart).RxCrcWrite] = ((uart).RxCrc == 0); \
+            (uart).RxCrcWrite = ((uart).RxCrcWrite + 1) % UART_CRC_QUEUE; \
+            (uart).RxCrcState = UART_REV_PRE; \
+        } \
+    } \
+    else if ((uart).RxCrcState == UART_REV_PRE) \
+    { \
+        if (dat == DTHD1) (uart).RxCrcState = UART_REV_GETFH1; \
+    } \
+    else if ((uart).RxCrcState == UART_REV_GETFH1) \
+    { \
+        (uart).RxCrcState = (dat == DTHD2) ? UART_REV_GETFH2 : UART_REV_PRE; \
+    } \
+    else if ((uart).RxCrcState == UART_REV_GETFH2) \
+    { \
+        (uart).RxCrcLeft = dat; \
+        (uart).RxCrcState = (dat < 3) ? UART_REV_PRE : UART_REV_GETLEN; \
+    } \
+    else \
+    { \
+        if (UART_FRAME_CMD(dat)) \
+        { \
+            (uart).RxCrc = CRC16_INIT; \
+            CRC16_UPDATE((uart).RxCrc, idx, dat); \
+            (uart).RxCrcLeft--; \
+            (uart).RxCrcState = UART_REV_GETBODY; \
+        } \
+        else \
+        { \
+            (uart).RxCrcState = UART_REV_PRE; \
+        } \
+    } \
+}
 
 //==============================================================================
 //---------------------------------Variables------------------------------------
@@ -57,6 +127,7 @@ Uartx_Frame_Data xdata Uart5_Frame; ///< UART5 frame data.
 bit ResponseFlag = 0;               ///< Response flag.
 bit AutoDataUpload = 0;             ///< Auto data upload flag.
 bit CrcCheckFlag = 0;               ///< CRC check flag.
+uint8_t CrcFrameState = CRC_FRAME_UNKNOWN; ///< CRC verdict of the frame being dispatched.
 
 //==============================================================================
 //--------------------------------Functions-------------------------------------
@@ -79,6 +150,9 @@ static void Uart2Init(void)
     Uart2.Response = RESPONSE_UART2;
     Uart2.CrcCheck = CRC_CHECK_UART2;
     Uart2.Delay = DELAY_UART2;
+    Uart2.RxCrcState = UART_REV_PRE;
+    Uart2.RxCrcRead = 0;
+    Uart2.RxCrcWrite = 0;
     for (i = 0; i < UART_TX_LENGTH; i++) Uart2.TxBuffer[i] = 0;
     for (i = 0; i < UART_RX_LENGTH; i++) Uart2.RxBuffer[i] = 0;
     i = 1024 - FOSC / 64 / BAUD_UART2;
@@ -112,6 +186,9 @@ static void Uart3Init(void)
     Uart3.Response = RESPONSE_UART3;
     Uart3.CrcCheck = CRC_CHECK_UART3;
     Uart3.Delay = DELAY_UART3;
+    Uart3.RxCrcState = UART_REV_PRE;
+    Uart3.RxCrcRead = 0;
+    Uart3.RxCrcWrite = 0;
     for (i = 0; i < UART_TX_LENGTH; i++) Uart3.TxBuffer[i] = 0;
     for (i = 0; i < UART_RX_LENGTH; i++) Uart3.RxBuffer[i] = 0;
     i = 1024 - FOSC / 32 / BAUD_UART3;
@@ -143,6 +220,9 @@ static void Uart4Init(void)
     Uart4.Response = RESPONSE_UART4;
     Uart4.CrcCheck = CRC_CHECK_UART4;
     Uart4.Delay = DELAY_UART4;
+    Uart4.RxCrcState = UART_REV_PRE;
+    Uart4.RxCrcRead = 0;
+    Uart4.RxCrcWrite = 0;
     for (i = 0; i < UART_TX_LENGTH; i++) Uart4.TxBuffer[i] = 0;
     for (i = 0; i < UART_RX_LENGTH; i++) Uart4.RxBuffer[i] = 0;
     P0MDOUT |= 0x03;
@@ -177,6 +257,9 @@ static void Uart5Init(void)
     Uart5.Response = RESPONSE_UART5;
     Uart5.CrcCheck = CRC_CHECK_UART5;
     Uart5.Delay = DELAY_UART5;
+    Uart5.RxCrcState = UART_REV_PRE;
+    Uart5.RxCrcRead = 0;
+    Uart5.RxCrcWrite = 0;
     for (i = 0; i < UART_TX_LENGTH; i++) Uart5.TxBuffer[i] = 0;
     for (i = 0; i < UART_RX_LENGTH; i++) Uart5.RxBuffer[i] = 0;
     P0MDOUT |= 0x03;
@@ -213,20 +296,22 @@ void UartInit(void)
 
 /**
  * @brief Decrements delay counters for all enabled UART interfaces.
+ * @details Called from Timer2Isr. Signals the UART task when an interface
+ *          comes out of its start-up delay, so bytes already queued get parsed.
  */
 void InterfaceDelay(void)
 {
 #if UART2_ENABLE
-    if (Uart2.Delay > 0) Uart2.Delay--;
+    if (Uart2.Delay > 0 && --Uart2.Delay == 0) SCHED_SIGNAL_ISR(SCHED_TASK_UART);
 #endif
 #if UART3_ENABLE
-    if (Uart3.Delay > 0) Uart3.Delay--;
+    if (Uart3.Delay > 0 && --Uart3.Delay == 0) SCHED_SIGNAL_ISR(SCHED_TASK_UART);
 #endif
 #if UART4_ENABLE
-    if (Uart4.Delay > 0) Uart4.Delay--;
+    if (Uart4.Delay > 0 && --Uart4.Delay == 0) SCHED_SIGNAL_ISR(SCHED_TASK_UART);
 #endif
 #if UART5_ENABLE
-    if (Uart5.Delay > 0) Uart5.Delay--;
+    if (Uart5.Delay > 0 && --Uart5.Delay == 0) SCHED_SIGNAL_ISR(SCHED_TASK_UART);
 #endif
 }
 
@@ -294,6 +379,33 @@ void UartSendStr(uint8_t uart_number, uint8_t* str, uint8_t len)
     }
 }
 
+/**
+ * @brief Sends a frame and appends its CRC16 while queueing the bytes.
+ * @details arr[2] already counts the two CRC bytes. The CRC is updated byte
+ *          by byte as the frame goes into the TX buffer, so the frame is
+ *          walked once instead of once for Crc16Table() and once for sending.
+ * @param uart_number UART identifier (2, 3, 4, or 5).
+ * @param arr Frame starting with the header.
+ */
+void UartSendFrameCrc(uint8_t uart_number, uint8_t* arr)
+{
+    uint16_t crc = CRC16_INIT;
+    uint16_t i;
+    uint16_t len = (uint16_t)arr[2] + 1;
+    uint8_t idx;
+
+    UartSendByte(uart_number, arr[0]);
+    UartSendByte(uart_number, arr[1]);
+    UartSendByte(uart_number, arr[2]);
+    for (i = 3; i < len; i++)
+    {
+        CRC16_UPDATE(crc, idx, arr[i]);
+        UartSendByte(uart_number, arr[i]);
+    }
+    UartSendByte(uart_number, (uint8_t)crc);
+    UartSendByte(uart_number, (uint8_t)(crc >> 8));
+}
+
 /**
  * @brief Sends data over the specified UART with optional CRC.
  * @param arr Data array to send.
@@ -310,12 +422,8 @@ void UartDataSend(uint8_t* arr, uint8_t uart_num, bit auto_send, bit crc_ck)
         CrcCheckFlag = crc_ck;
         if (CrcCheckFlag)
         {
-            uint16_t crc = 0;
             arr[2] = (((uint8_t)v1) << 1) + 6;
-            crc = Crc16Table(arr + 3, arr[2] - 2);
-            arr[arr[2] + 1] = crc & 0x00FF;
-            arr[arr[2] + 2] = crc >> 8;
-            UartSendStr(uart_num, arr, arr[2] + 3);
+            UartSendFrameCrc(uart_num, arr);
             arr[2] = (((uint8_t)v1) << 1) + 4;
         }
         else
@@ -367,6 +475,73 @@ void Read0xF00(void)
     }
 }
 
+/**
+ * @brief Sends a prepared upload frame over one UART.
+ * @param uart_num UART identifier (2, 3, 4, or 5).
+ * @param arr Frame starting with the header, arr[2] not counting a CRC.
+ * @param crc_ck Append a CRC16.
+ */
+static void UartUploadFrame(uint8_t uart_num, uint8_t* arr, bit crc_ck)
+{
+    if (crc_ck)
+    {
+        arr[2] += 2;
+        UartSendFrameCrc(uart_num, arr);
+        arr[2] -= 2;
+    }
+    else
+    {
+        UartSendStr(uart_num, arr, arr[2] + 3);
+    }
+}
+
+/**
+ * @brief Uploads one VP word as a 0x83 frame on every UART with DATA_UPLOAD set.
+ * @param Addr VP address.
+ * @param Val VP value.
+ */
+void UartUploadVp(uint16_t Addr, uint16_t Val)
+{
+    uint8_t val[9];
+    val[0] = DTHD1;
+    val[1] = DTHD2;
+    val[2] = 6;
+    val[3] = 0x83;
+    val[4] = (uint8_t)(Addr >> 8);
+    val[5] = (uint8_t)Addr;
+    val[6] = 1;
+    val[7] = (uint8_t)(Val >> 8);
+    val[8] = (uint8_t)Val;
+#if UART2_ENABLE && DATA_UPLOAD_UART2
+    UartUploadFrame(2, val, CRC_CHECK_UART2);
+#endif
+#if UART3_ENABLE && DATA_UPLOAD_UART3
+    UartUploadFrame(3, val, CRC_CHECK_UART3);
+#endif
+#if UART4_ENABLE && DATA_UPLOAD_UART4
+    UartUploadFrame(4, val, CRC_CHECK_UART4);
+#endif
+#if UART5_ENABLE && DATA_UPLOAD_UART5
+    UartUploadFrame(5, val, CRC_CHECK_UART5);
+#endif
+}
+
+/**
+ * @brief Checks the CRC16 of the frame being dispatched.
+ * @details Uses the verdict computed in the RX ISR when there is one and
+ *          only falls back to Crc16Table() for frames the ISR did not track.
+ * @param arr Frame starting with the header.
+ * @return bit 1 if the CRC matches.
+ */
+static bit UartFrameCrcValid(uint8_t* arr)
+{
+    uint16_t crc, crc_check;
+    if (CrcFrameState != CRC_FRAME_UNKNOWN) return (CrcFrameState == CRC_FRAME_OK);
+    crc = Crc16Table(&arr[3], arr[2] - 2);
+    crc_check = (uint16_t)(arr[3 + arr[2] - 1] << 8) + (uint16_t)(arr[3 + arr[2] - 2]);
+    return (crc == crc_check);
+}
+
 /**
  * @brief Processes command 0x82 for writing data to DGUS registers.
  * @param uart_num UART identifier (2, 3, 4, or 5).
@@ -380,7 +555,7 @@ void Deal82Cmd(uint8_t uart_num, uint8_t* arr)
         {
             arr[7] = 0xA5;
         }
-        WriteDgusVp((arr[4] << 8) + arr[5], arr + 6, arr[2] - 3);
+        WriteDgusVp((arr[4] << 8) + arr[5], arr + 6, (arr[2] - 3) >> 1);
         if (ResponseFlag)
         {
             uint8_t temp_arr[] = {DTHD1, DTHD2, 0x03, 0x82, 0x4F, 0x4B};
@@ -389,11 +564,9 @@ void Deal82Cmd(uint8_t uart_num, uint8_t* arr)
     }
     else
     {
-        uint16_t crc = Crc16Table(&arr[3], arr[2] - 2);
-        uint16_t crc_check = (uint16_t)(arr[3 + arr[2] - 1] << 8) + (uint16_t)(arr[3 + arr[2] - 2]);
-        if (crc == crc_check)
+        if (UartFrameCrcValid(arr))
         {
-            WriteDgusVp((arr[4] << 8) + arr[5], arr + 6, arr[2] - 5);
+            WriteDgusVp((arr[4] << 8) + arr[5], arr + 6, (arr[2] - 5) >> 1);
             if (ResponseFlag)
             {
                 uint8_t temp_arr[] = {DTHD1, DTHD2, 0x05, 0x82, 0x4F, 0x4B, 0xA5, 0xEF};
@@ -421,18 +594,12 @@ void Deal83Cmd(uint8_t uart_num, uint8_t* arr, uint8_t* arr1)
     }
     else
     {
-        uint16_t crc, crc_check;
         for (i = 0; i < 9; i++) arr[i] = arr1[i];
-        crc = Crc16Table(&arr[3], arr[2] - 2);
-        crc_check = (uint16_t)(arr[3 + arr[2] - 1] << 8) + (uint16_t)(arr[3 + arr[2] - 2]);
-        if (crc == crc_check)
+        if (UartFrameCrcValid(arr))
         {
             ReadDgusVp((arr[4] << 8) + arr[5], &arr[7], arr[6]);
             arr[2] = (2 * arr[6]) + 4 + 2;
-            crc = Crc16Table(arr + 3, arr[2] - 2);
-            arr[arr[2] + 1] = crc & 0x00FF;
-            arr[arr[2] + 2] = crc >> 8;
-            UartSendStr(uart_num, arr, arr[2] + 3);
+            UartSendFrameCrc(uart_num, arr);
         }
     }
 }
@@ -460,7 +627,46 @@ void DealUartData(uint8_t* arr_rece, uint8_t uart_num, uint8_t response, uint8_t
             CrcCheckFlag = crc_ck;
             Deal83Cmd(uart_num, val, arr_rece);
         }
+#if TRACE_ENABLE
+        else if (arr_rece[3] == TRACE_CMD)
+        {
+            if (arr_rece[2] == TRACE_REQ_LEN + (crc_ck ? 2 : 0) && (crc_ck == 0 || UartFrameCrcValid(arr_rece)))
+            {
+                TraceDump(uart_num, crc_ck, arr_rece[5]);
+            }
+        }
+#endif
+    }
+}
+
+/**
+ * @brief Takes the RX ISR CRC verdict for the frame ending at RxRead.
+ * @details Verdicts for frames the main loop parsed differently are dropped.
+ *          Verdicts for frames still waiting in the ring are kept.
+ * @param uart Pointer to UART configuration structure.
+ * @return uint8_t CRC_FRAME_OK, CRC_FRAME_BAD or CRC_FRAME_UNKNOWN.
+ */
+static uint8_t UartRxCrcVerdict(Uartx_Define* uart)
+{
+    uint16_t ahead, pending;
+    uint8_t verdict = CRC_FRAME_UNKNOWN;
+
+    EA = 0;
+    pending = (uart->RxWrite - uart->RxRead + UART_RX_LENGTH) % UART_RX_LENGTH;
+    while (uart->RxCrcRead != uart->RxCrcWrite)
+    {
+        ahead = (uart->RxCrcEnd[uart->RxCrcRead] - uart->RxRead + UART_RX_LENGTH) % UART_RX_LENGTH;
+        if (ahead == 0)
+        {
+            verdict = uart->RxCrcOk[uart->RxCrcRead] ? CRC_FRAME_OK : CRC_FRAME_BAD;
+            uart->RxCrcRead = (uart->RxCrcRead + 1) % UART_CRC_QUEUE;
+            break;
+        }
+        if (ahead <= pending) break;
+        uart->RxCrcRead = (uart->RxCrcRead + 1) % UART_CRC_QUEUE;
     }
+    EA = 1;
+    return verdict;
 }
 
 /**
@@ -520,6 +726,7 @@ void UartHandleFrame(Uartx_Define* uart)
             else
             {
                 uart->RxFlag = UART_REV_PRE;
+                TraceEvent(TRACE_EV_FRAME_DROP, ((uint16_t)uart->Id << 8) | c);
             }
         }
         else if (uart->RxFlag == UART_REV_GETFH2)
@@ -527,6 +734,7 @@ void UartHandleFrame(Uartx_Define* uart)
             if (c < 3 || c > UARTX_FRAME_DATA_LENGTH)
             {
                 uart->RxFlag = UART_REV_PRE;
+                TraceEvent(TRACE_EV_FRAME_DROP, ((uint16_t)uart->Id << 8) | c);
             }
             else
             {
@@ -537,7 +745,7 @@ void UartHandleFrame(Uartx_Define* uart)
         }
         else if (uart->RxFlag == UART_REV_GETLEN)
         {
-            if (c != 0x82 && c != 0x83)
+            if (!UART_FRAME_CMD(c))
             {
                 if (c == 0x80 || c == 0x81)
                 {
@@ -549,6 +757,7 @@ void UartHandleFrame(Uartx_Define* uart)
                 else
                 {
                     uart->RxFlag = UART_REV_PRE;
+                    TraceEvent(TRACE_EV_FRAME_DROP, ((uint16_t)uart->Id << 8) | c);
                 }
             }
             else
@@ -583,6 +792,15 @@ void UartHandleFrame(Uartx_Define* uart)
     if (uart->RxFlag == UART_REV_DONE)
     {
         uart->RxFlag = UART_REV_PRE;
+        CrcFrameState = uart->CrcCheck ? UartRxCrcVerdict(uart) : CRC_FRAME_UNKNOWN;
+#if TRACE_ENABLE
+        if (uart->CrcCheck && CrcFrameState == CRC_FRAME_UNKNOWN)
+        {
+            CrcFrameState = UartFrameCrcValid(uart_data->VarData) ? CRC_FRAME_OK : CRC_FRAME_BAD;
+        }
+        TraceEvent(CrcFrameState == CRC_FRAME_BAD ? TRACE_EV_FRAME_BAD : TRACE_EV_FRAME_OK,
+                   ((uint16_t)uart->Id << 8) | uart_data->DataCode);
+#endif
         DealUartData(uart_data->VarData, uart->Id, uart->Response, uart->CrcCheck);
     }
 }
@@ -606,19 +824,52 @@ void UartProcess(void)
 #endif
 }
 
+/**
+ * @brief Checks for received bytes not yet parsed by UartProcess().
+ * @details Interfaces still in their start-up delay are ignored, they are
+ *          picked up once InterfaceDelay() signals the UART task.
+ * @return bit 1 if any enabled interface has pending RX data.
+ */
+bit UartRxPending(void)
+{
+#if UART2_ENABLE
+    if (Uart2.Delay == 0 && Uart2.RxRead != Uart2.RxWrite) return 1;
+#endif
+#if UART3_ENABLE
+    if (Uart3.Delay == 0 && Uart3.RxRead != Uart3.RxWrite) return 1;
+#endif
+#if UART4_ENABLE
+    if (Uart4.Delay == 0 && Uart4.RxRead != Uart4.RxWrite) return 1;
+#endif
+#if UART5_ENABLE
+    if (Uart5.Delay == 0 && Uart5.RxRead != Uart5.RxWrite) return 1;
+#endif
+    return 0;
+}
+
 #if UART2_ENABLE
 /**
  * @brief Interrupt service routine for UART2 transmit and receive.
+ * @details The UART ISRs leave EA alone: their own source is masked while
+ *          they run and the other low priority ISRs cannot preempt them,
+ *          while the high priority pulse edge ISRs must get through.
  */
 void Uart2TxRxIsr(void) interrupt 4
 {
-    EA = 0;
+    TRACE_ISR_ENTER(4);
+    DIAG_ISR_ENTER();
     if (RI0 == 1)
     {
+        uint8_t c = SBUF0;  //Read once: the CRC tracker uses the same byte
+
         RI0 = 0;
-        Uart2.RxBuffer[Uart2.RxWrite] = SBUF0;
+        Uart2.RxBuffer[Uart2.RxWrite] = c;
         Uart2.RxWrite++;
         Uart2.RxWrite %= UART_RX_LENGTH;
+#if CRC_CHECK_UART2
+        UART_RX_CRC_TRACK(Uart2, c);
+#endif
+        SCHED_SIGNAL_ISR(SCHED_TASK_UART);
     }
     else if (TI0 == 1)
     {
@@ -634,7 +885,8 @@ void Uart2TxRxIsr(void) interrupt 4
             Uart2.TxBusy = 0;
         }
     }
-    EA = 1;
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(4);
 }
 #endif
 
@@ -644,12 +896,20 @@ void Uart2TxRxIsr(void) interrupt 4
  */
 void Uart3RxIsr(void) interrupt 16
 {
+    TRACE_ISR_ENTER(16);
+    DIAG_ISR_ENTER();
     if (SCON1 & 0x01)
     {
+        uint8_t c = SBUF1;
+
         SCON1 &= 0xFE;
-        Uart3.RxBuffer[Uart3.RxWrite] = SBUF1;
+        Uart3.RxBuffer[Uart3.RxWrite] = c;
         Uart3.RxWrite++;
         Uart3.RxWrite %= UART_RX_LENGTH;
+#if CRC_CHECK_UART3
+        UART_RX_CRC_TRACK(Uart3, c);
+#endif
+        SCHED_SIGNAL_ISR(SCHED_TASK_UART);
     }
     else if (SCON1 & 0x02)
     {
@@ -665,6 +925,8 @@ void Uart3RxIsr(void) interrupt 16
             Uart3.TxBusy = 0;
         }
     }
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(16);
 }
 #endif
 
@@ -674,12 +936,21 @@ void Uart3RxIsr(void) interrupt 16
  */
 void Uart4RxIsr(void) interrupt 11
 {
-    EA = 0;
+    uint8_t c;
+
+    TRACE_ISR_ENTER(11);
+    DIAG_ISR_ENTER();
     SCON2R &= 0xFE;
-    Uart4.RxBuffer[Uart4.RxWrite] = SBUF2_RX;
+    c = SBUF2_RX;
+    Uart4.RxBuffer[Uart4.RxWrite] = c;
     Uart4.RxWrite++;
     Uart4.RxWrite %= UART_RX_LENGTH;
-    EA = 1;
+#if CRC_CHECK_UART4
+    UART_RX_CRC_TRACK(Uart4, c);
+#endif
+    SCHED_SIGNAL_ISR(SCHED_TASK_UART);
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(11);
 }
 
 /**
@@ -687,7 +958,8 @@ void Uart4RxIsr(void) interrupt 11
  */
 void Uart4TxIsr(void) interrupt 10
 {
-    EA = 0;
+    TRACE_ISR_ENTER(10);
+    DIAG_ISR_ENTER();
     SCON2T &= 0xFE;
     if (Uart4.TxRead != Uart4.TxWrite)
     {
@@ -700,7 +972,8 @@ void Uart4TxIsr(void) interrupt 10
         TR4 = 0;
         Uart4.TxBusy = 0;
     }
-    EA = 1;
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(10);
 }
 #endif
 
@@ -710,12 +983,21 @@ void Uart4TxIsr(void) interrupt 10
  */
 void Uart5RxIsr(void) interrupt 13
 {
-    EA = 0;
+    uint8_t c;
+
+    TRACE_ISR_ENTER(13);
+    DIAG_ISR_ENTER();
     SCON3R &= 0xFE;
-    Uart5.RxBuffer[Uart5.RxWrite] = SBUF3_RX;
+    c = SBUF3_RX;
+    Uart5.RxBuffer[Uart5.RxWrite] = c;
     Uart5.RxWrite++;
     Uart5.RxWrite %= UART_RX_LENGTH;
-    EA = 1;
+#if CRC_CHECK_UART5
+    UART_RX_CRC_TRACK(Uart5, c);
+#endif
+    SCHED_SIGNAL_ISR(SCHED_TASK_UART);
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(13);
 }
 
 /**
@@ -723,7 +1005,8 @@ void Uart5RxIsr(void) interrupt 13
  */
 void Uart5TxIsr(void) interrupt 12
 {
-    EA = 0;
+    TRACE_ISR_ENTER(12);
+    DIAG_ISR_ENTER();
     SCON3T &= 0xFE;
     if (Uart5.TxRead != Uart5.TxWrite)
     {
@@ -735,6 +1018,7 @@ void Uart5TxIsr(void) interrupt 12
     {
         Uart5.TxBusy = 0;
     }
-    EA = 1;
+    DIAG_ISR_EXIT();
+    TRACE_ISR_EXIT(12);
 }
 #endif
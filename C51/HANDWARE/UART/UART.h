@@ -35,7 +35,7 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "SYSTEM.h"
-#include "crc16.h"
+#include "CRC16.h"
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
@@ -48,11 +48,17 @@ SOFTWARE.
 #define UART_REV_GETADDR1     0x05
 #define UART_REV_GETADDR2     0x06
 #define UART_REV_DONE         0x07
+#define UART_REV_GETBODY      0x08
+
+#define CRC_FRAME_UNKNOWN     0x00
+#define CRC_FRAME_OK          0x01
+#define CRC_FRAME_BAD         0x02
 
 #define UART_TX_LENGTH        256
 #define UART_RX_LENGTH        1024
 #define TIMEOUT_SET           10
 #define UARTX_FRAME_DATA_LENGTH 264
+#define UART_CRC_QUEUE        4
 
 //==============================================================================
 //--------------------------------Structures------------------------------------
@@ -75,6 +81,13 @@ typedef struct
     uint8_t  Response;         ///< Response enable flag.
     uint8_t  CrcCheck;         ///< CRC check enable flag.
     uint8_t  Delay;            ///< Delay counter for response (in ms).
+    uint8_t  RxCrcState;       ///< Frame tracker state in the RX ISR.
+    uint8_t  RxCrcLeft;        ///< Bytes left in the tracked frame.
+    uint16_t RxCrc;            ///< Running CRC16 of the tracked frame.
+    uint16_t RxCrcEnd[UART_CRC_QUEUE]; ///< RxWrite index at the end of each checked frame.
+    uint8_t  RxCrcOk[UART_CRC_QUEUE];  ///< CRC verdict of each checked frame.
+    uint8_t  RxCrcRead;        ///< CRC verdict queue read pointer.
+    uint8_t  RxCrcWrite;       ///< CRC verdict queue write pointer.
 } Uartx_Define;
 
 /**
@@ -102,6 +115,12 @@ void UartInit(void);
  */
 void UartProcess(void);
 
+/**
+ * @brief Checks for received bytes not yet parsed by UartProcess().
+ * @return bit 1 if any enabled interface has pending RX data.
+ */
+bit UartRxPending(void);
+
 /**
  * @brief Decrements delay counters for all enabled UART interfaces.
  */
@@ -113,4 +132,26 @@ void InterfaceDelay(void);
  * @param dat Byte to send.
  */
 void UartSendByte(uint8_t uart_number, uint8_t dat);
+
+/**
+ * @brief Sends a string of bytes over the specified UART.
+ * @param uart_number UART identifier (2, 3, 4, or 5).
+ * @param str Pointer to the byte array to send.
+ * @param len Length of the byte array.
+ */
+void UartSendStr(uint8_t uart_number, uint8_t* str, uint8_t len);
+
+/**
+ * @brief Sends a frame and appends its CRC16 while queueing the bytes.
+ * @param uart_number UART identifier (2, 3, 4, or 5).
+ * @param arr Frame starting with the header, arr[2] counting the CRC bytes.
+ */
+void UartSendFrameCrc(uint8_t uart_number, uint8_t* arr);
+
+/**
+ * @brief Uploads one VP word as a 0x83 frame on every UART with DATA_UPLOAD set.
+ * @param Addr VP address.
+ * @param Val VP value.
+ */
+void UartUploadVp(uint16_t Addr, uint16_t Val);
 #endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "WAVE.h"
+#include "PWM.h"
+#include "SoftTimer.h"
+
+#if WAVE_PERIOD_MS < PWM_OUT_INTERVAL_MS
+#error "WAVE_PERIOD_MS must not be shorter than PWM_OUT_INTERVAL_MS"
+#endif
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+static xdata uint16_t WaveVpTable[1 << WAVE_TABLE_BITS_MAX];	///< Table loaded by WavePlayVp().
+static uint16_t * xdata WaveTable;						///< Table being played.
+static xdata uint8_t WaveShift;							///< 32 - table bits.
+static xdata uint32_t WavePhase;							///< Phase accumulator.
+static xdata uint32_t WaveStep;							///< Phase step per tick.
+static xdata uint8_t WaveTimer = SOFT_TIMER_NONE;		///< Sample tick, running while playing.
+static xdata uint16_t WaveTicks;							///< Ticks in the current rate window.
+static xdata uint16_t WaveFrames0;						///< PwmOutFrames() at the start of the window.
+static xdata uint16_t WaveRateHz;						///< Frames in the last full window.
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Sample tick: outputs the sample at the current phase and advances it.
+ */
+static void WaveTick(void)
+{
+    DacSetOut(WaveTable[(uint8_t)(WavePhase >> WaveShift)]);
+    WavePhase += WaveStep;
+
+    if (++WaveTicks >= WAVE_RATE_HZ)
+    {
+        WaveRateHz = PwmOutFrames() - WaveFrames0;
+        WaveFrames0 += WaveRateHz;
+        WaveTicks = 0;
+    }
+}
+
+/**
+ * @brief Changes the frequency without a phase jump.
+ * @param FreqMhz Output frequency in mHz.
+ * @return StatusWave WAVE_OK, or WAVE_ERR above WAVE_FREQ_MAX_MHZ.
+ */
+StatusWave WaveSetFreq(uint32_t FreqMhz)
+{
+    if (FreqMhz > WAVE_FREQ_MAX_MHZ) return WAVE_ERR;
+    WaveStep = FreqMhz * WAVE_STEP_PER_MHZ;
+    return WAVE_OK;
+}
+
+/**
+ * @brief Plays a sample table to the DAC.
+ * @param Table Samples in mV, 1 << Bits entries.
+ * @param Bits log2 of the table length (1 to WAVE_TABLE_BITS_MAX).
+ * @param FreqMhz Output frequency in mHz.
+ * @return StatusWave WAVE_OK, or WAVE_ERR for a bad length or frequency.
+ */
+StatusWave WavePlay(uint16_t *Table, uint8_t Bits, uint32_t FreqMhz)
+{
+    if (Table == 0 || Bits < 1 || Bits > WAVE_TABLE_BITS_MAX) return WAVE_ERR;
+    if (WaveSetFreq(FreqMhz) != WAVE_OK) return WAVE_ERR;
+    WaveTable = Table;
+    WaveShift = 32 - Bits;
+    WavePhase = 0;
+    if (WaveTimer == SOFT_TIMER_NONE)
+    {
+        WaveTicks = 0;
+        WaveFrames0 = PwmOutFrames();
+        WaveRateHz = 0;
+        WaveTimer = SoftTimerStart(WaveTick, 0, WAVE_PERIOD_MS);
+    }
+    return WAVE_OK;
+}
+
+/**
+ * @brief Loads a table from VP words and plays it.
+ * @param Vp First VP of the samples (mV, one word each).
+ * @param Bits log2 of the number of samples (1 to WAVE_TABLE_BITS_MAX).
+ * @param FreqMhz Output frequency in mHz.
+ * @return StatusWave WAVE_OK, or WAVE_ERR for a bad length or frequency.
+ */
+StatusWave WavePlayVp(uint16_t Vp, uint8_t Bits, uint32_t FreqMhz)
+{
+    if (Bits < 1 || Bits > WAVE_TABLE_BITS_MAX || FreqMhz > WAVE_FREQ_MAX_MHZ) return WAVE_ERR;
+    //Stop first: the buffer may be the table being played
+    WaveStop();
+    ReadDgusVp(Vp, (uint8_t*)WaveVpTable, (uint16_t)1 << Bits);
+    return WavePlay(WaveVpTable, Bits, FreqMhz);
+}
+
+/**
+ * @brief Stops playback; the DAC keeps the last sample.
+ */
+void WaveStop(void)
+{
+    if (WaveTimer != SOFT_TIMER_NONE) SoftTimerStop(WaveTimer);
+    WaveTimer = SOFT_TIMER_NONE;
+    WaveRateHz = 0;
+}
+
+/**
+ * @brief Returns the DAC frames sent in the last full second of playback.
+ * @return uint16_t Achieved update rate in Hz.
+ */
+uint16_t WaveRate(void)
+{
+    return WaveRateHz;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,145 @@
+#ifndef __WAVE_H__
+#define __WAVE_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+/**
+ * @def WAVE_TABLE_BITS_STD
+ * @brief log2 of the length of the built-in tables.
+ */
+#define WAVE_TABLE_BITS_STD		6
+
+/**
+ * @def WAVE_TABLE_BITS_MAX
+ * @brief Largest table, as log2 (256 samples).
+ */
+#define WAVE_TABLE_BITS_MAX		8
+
+/**
+ * @def WAVE_RATE_HZ
+ * @brief Sample rate of the engine.
+ */
+#define WAVE_RATE_HZ			(1000 / WAVE_PERIOD_MS)
+
+/**
+ * @def WAVE_STEP_PER_MHZ
+ * @brief Phase step per tick for 1 mHz: 2^32 / (1000 * WAVE_RATE_HZ), folded by the compiler.
+ */
+#define WAVE_STEP_PER_MHZ		((uint32_t)(4294967.296 / WAVE_RATE_HZ + 0.5))
+
+/**
+ * @def WAVE_FREQ_MAX_MHZ
+ * @brief Highest frequency accepted, in mHz (half the sample rate).
+ */
+#define WAVE_FREQ_MAX_MHZ		(500UL * WAVE_RATE_HZ)
+
+/**
+ * @brief Enum for waveform operation status.
+ */
+typedef enum
+{
+    WAVE_OK = 0x00,  ///< Operation successful.
+    WAVE_ERR = 0xFF, ///< Invalid table or frequency.
+} StatusWave;
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Built-in sine, 64 samples in mV. */
+extern code uint16_t WaveSine[1 << WAVE_TABLE_BITS_STD];
+
+/** @brief Built-in triangle, 64 samples in mV. */
+extern code uint16_t WaveTriangle[1 << WAVE_TABLE_BITS_STD];
+
+/** @brief Built-in rising ramp, 64 samples in mV. */
+extern code uint16_t WaveRamp[1 << WAVE_TABLE_BITS_STD];
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+/**
+ * @brief Plays a sample table to the DAC.
+ * @details Every WAVE_PERIOD_MS a 32-bit phase accumulator advances by a
+ *          step set from the frequency and its top Bits select the sample
+ *          passed to DacSetOut(). The table stays in place (CODE or XDATA)
+ *          and is read through a generic pointer. DAC frames are limited to
+ *          one per PWM_OUT_INTERVAL_MS by the PWM output queue, so
+ *          WAVE_PERIOD_MS is kept at or above it.
+ * @param Table Samples in mV, 1 << Bits entries.
+ * @param Bits log2 of the table length (1 to WAVE_TABLE_BITS_MAX).
+ * @param FreqMhz Output frequency in mHz (one table pass per period).
+ * @return StatusWave WAVE_OK, or WAVE_ERR for a bad length or frequency.
+ */
+StatusWave WavePlay(uint16_t *Table, uint8_t Bits, uint32_t FreqMhz);
+
+/**
+ * @brief Loads a table from VP words and plays it.
+ * @details The samples are copied to XDATA first, so the VP block may be
+ *          rewritten while the table plays.
+ * @param Vp First VP of the samples (mV, one word each).
+ * @param Bits log2 of the number of samples (1 to WAVE_TABLE_BITS_MAX).
+ * @param FreqMhz Output frequency in mHz.
+ * @return StatusWave WAVE_OK, or WAVE_ERR for a bad length or frequency.
+ */
+StatusWave WavePlayVp(uint16_t Vp, uint8_t Bits, uint32_t FreqMhz);
+
+/**
+ * @brief Changes the frequency without a phase jump.
+ * @param FreqMhz Output frequency in mHz.
+ * @return StatusWave WAVE_OK, or WAVE_ERR above WAVE_FREQ_MAX_MHZ.
+ */
+StatusWave WaveSetFreq(uint32_t FreqMhz);
+
+/**
+ * @brief Stops playback; the DAC keeps the last sample.
+ */
+void WaveStop(void);
+
+/**
+ * @brief Returns the DAC frames sent in the last full second of playback.
+ * @details Counts frames that actually went to UART3, so coalescing by the
+ *          output queue shows up here. 0 when stopped.
+ * @return uint16_t Achieved update rate in Hz.
+ */
+uint16_t WaveRate(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file WaveTable.c
+ * @brief Built-in DAC waveforms in CODE, WAVE_TABLE_BITS_STD (64) samples in mV.
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "WAVE.h"
+
+//==============================================================================
+//---------------------------------VARIABLES------------------------------------
+//==============================================================================
+/** @brief One sine period, 0 to 10000 mV, starting at mid-scale. */
+code uint16_t WaveSine[1 << WAVE_TABLE_BITS_STD] =
+{
+     5000,  5490,  5975,  6451,  6913,  7357,  7778,  8172,
+     8536,  8865,  9157,  9410,  9619,  9785,  9904,  9976,
+    10000,  9976,  9904,  9785,  9619,  9410,  9157,  8865,
+     8536,  8172,  7778,  7357,  6913,  6451,  5975,  5490,
+     5000,  4510,  4025,  3549,  3087,  2643,  2222,  1828,
+     1464,  1135,   843,   590,   381,   215,    96,    24,
+        0,    24,    96,   215,   381,   590,   843,  1135,
+     1464,  1828,  2222,  2643,  3087,  3549,  4025,  4510,
+};
+
+/** @brief Triangle, 0 up to 10000 mV and back. */
+code uint16_t WaveTriangle[1 << WAVE_TABLE_BITS_STD] =
+{
+        0,   312,   625,   938,  1250,  1562,  1875,  2188,
+     2500,  2812,  3125,  3438,  3750,  4062,  4375,  4688,
+     5000,  5312,  5625,  5938,  6250,  6562,  6875,  7188,
+     7500,  7812,  8125,  8438,  8750,  9062,  9375,  9688,
+    10000,  9688,  9375,  9062,  8750,  8438,  8125,  7812,
+     7500,  7188,  6875,  6562,  6250,  5938,  5625,  5312,
+     5000,  4688,  4375,  4062,  3750,  3438,  3125,  2812,
+     2500,  2188,  1875,  1562,  1250,   938,   625,   312,
+};
+
+/** @brief Rising ramp, 0 to 10000 mV, then back to 0. */
+code uint16_t WaveRamp[1 << WAVE_TABLE_BITS_STD] =
+{
+        0,   159,   317,   476,   635,   794,   952,  1111,
+     1270,  1429,  1587,  1746,  1905,  2063,  2222,  2381,
+     2540,  2698,  2857,  3016,  3175,  3333,  3492,  3651,
+     3810,  3968,  4127,  4286,  4444,  4603,  4762,  4921,
+     5079,  5238,  5397,  5556,  5714,  5873,  6032,  6190,
+     6349,  6508,  6667,  6825,  6984,  7143,  7302,  7460,
+     7619,  7778,  7937,  8095,  8254,  8413,  8571,  8730,
+     8889,  9048,  9206,  9365,  9524,  9683,  9841, 10000,
+};
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
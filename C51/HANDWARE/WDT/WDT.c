@@ -33,11 +33,43 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "WDT.h"
+#if WDT_SUP_ENABLE
+#include "SoftTimer.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
 
+#if WDT_SUP_ENABLE
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/**
+ * @var WdtFault WdtFaultRec
+ * @brief Fault record. No initializer: the startup code leaves it alone,
+ *        so it still holds the cause after the watchdog reset.
+ */
+WdtFault xdata WdtFaultRec;
+
+/**
+ * @var uint8_t WdtSupArmed
+ * @brief Stall detector is running.
+ */
+uint8_t data WdtSupArmed = 0;
+
+/**
+ * @var uint16_t WdtSupStallMs
+ * @brief Milliseconds since the supervisor was last serviced.
+ */
+uint16_t xdata WdtSupStallMs = 0;
+
+static uint8_t  xdata WdtSupCount = 0;                      ///< Registered tasks.
+static uint8_t  xdata WdtSupTask[WDT_SUP_TASKS];            ///< Task ID per entry.
+static uint16_t xdata WdtSupDeadline[WDT_SUP_TASKS];        ///< Deadline per entry, ms.
+static uint32_t xdata WdtSupLast[WDT_SUP_TASKS];            ///< Last check-in, ms.
+#endif
+
 //==============================================================================
 //--------------------------------FUNCTIONS-------------------------------------
 //==============================================================================
@@ -68,6 +100,114 @@ void WDTRefresh(void)
     MUX_SEL |= 0x01;
 }
 
+#if WDT_SUP_ENABLE
+/**
+ * @brief Writes the fault record to WDT_SUP_VP.
+ */
+static void WdtSupPublish(void)
+{
+    uint16_t vp[WDT_SUP_VP_WORDS];
+
+    vp[0] = WdtFaultRec.Resets;
+    vp[1] = WdtFaultRec.Cause;
+    vp[2] = WdtFaultRec.Task;
+    vp[3] = (uint16_t)(WdtFaultRec.Ms >> 16);
+    vp[4] = (uint16_t)WdtFaultRec.Ms;
+    WriteDgusVp(WDT_SUP_VP, (uint8_t*)vp, WDT_SUP_VP_WORDS);
+}
+
+/**
+ * @brief Publishes the fault record left by a supervisor reset and clears the task table.
+ * @details A record without the magic is power-up garbage and is cleared.
+ */
+void WdtSupInit(void)
+{
+    if (WdtFaultRec.Magic != WDT_FAULT_MAGIC)
+    {
+        WdtFaultRec.Magic = WDT_FAULT_MAGIC;
+        WdtFaultRec.Cause = WDT_CAUSE_NONE;
+        WdtFaultRec.Task = SCHED_TASK_NONE;
+        WdtFaultRec.Ms = 0;
+        WdtFaultRec.Resets = 0;
+    }
+    else if (WdtFaultRec.Pending)
+    {
+        WdtFaultRec.Resets++;
+    }
+    WdtFaultRec.Pending = 0;
+    WdtSupPublish();
+    WdtSupArmed = 0;
+    WdtSupCount = 0;
+}
+
+/**
+ * @brief Registers a task that must check in periodically.
+ * @param Task ID recorded when it misses its deadline (scheduler task ID).
+ * @param DeadlineMs Longest allowed time between check-ins.
+ * @return uint8_t Handle for WdtSupCheckIn(), WDT_SUP_NONE if the table is full.
+ */
+uint8_t WdtSupRegister(uint8_t Task, uint16_t DeadlineMs)
+{
+    if (WdtSupCount >= WDT_SUP_TASKS) return WDT_SUP_NONE;
+    WdtSupTask[WdtSupCount] = Task;
+    WdtSupDeadline[WdtSupCount] = DeadlineMs;
+    WdtSupLast[WdtSupCount] = TimeNowMs();
+    return WdtSupCount++;
+}
+
+/**
+ * @brief Reports a task as alive.
+ * @param Id Handle from WdtSupRegister().
+ */
+void WdtSupCheckIn(uint8_t Id)
+{
+    if (Id < WdtSupCount) WdtSupLast[Id] = TimeNowMs();
+}
+
+/**
+ * @brief Periodic service: refreshes the watchdog only if every task is on time.
+ * @details Runs as a software timer callback, so a stuck main loop also
+ *          stops the refresh. The first late task is recorded and the
+ *          refresh withheld until the hardware watchdog resets the CPU.
+ */
+static void WdtSupService(void)
+{
+    uint32_t now = TimeNowMs();
+    uint8_t i;
+
+    if (WdtFaultRec.Pending) return;
+    for (i = 0; i < WdtSupCount; i++)
+    {
+        if (now - WdtSupLast[i] > WdtSupDeadline[i])
+        {
+            EA = 0;
+            WdtFaultRec.Cause = WDT_CAUSE_DEADLINE;
+            WdtFaultRec.Task = WdtSupTask[i];
+            WdtFaultRec.Ms = now;
+            WdtFaultRec.Pending = 1;
+            EA = 1;
+            WdtSupPublish();
+            return;
+        }
+    }
+    EA = 0;
+    WdtSupStallMs = 0;
+    EA = 1;
+    WDTRefresh();
+}
+
+/**
+ * @brief Starts the hardware watchdog and the periodic service.
+ */
+void WdtSupStart(void)
+{
+    SoftTimerStart(WdtSupService, WDT_SUP_PERIOD_MS, WDT_SUP_PERIOD_MS);
+    WDTRefresh();
+    WDTStart();
+    WdtSupArmed = 1;
+}
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
\ No newline at end of file
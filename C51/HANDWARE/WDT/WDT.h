@@ -35,10 +35,99 @@ SOFTWARE.
 //---------------------------------Includes-------------------------------------
 //==============================================================================
 #include "SYSTEM.h"
+#if WDT_SUP_ENABLE
+#include "SCHEDULER.h"
+#endif
 
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
+/**
+ * @def WDT_SUP_NONE
+ * @brief Invalid supervisor handle.
+ */
+#define WDT_SUP_NONE			0xFF
+
+/**
+ * @def WDT_FAULT_MAGIC
+ * @brief Marks a valid fault record in RAM that survived the reset.
+ */
+#define WDT_FAULT_MAGIC			0x57445446UL
+
+/**
+ * @def WDT_CAUSE_NONE
+ * @brief No supervisor fault recorded.
+ */
+#define WDT_CAUSE_NONE			0
+
+/**
+ * @def WDT_CAUSE_DEADLINE
+ * @brief A registered task missed its check-in deadline.
+ */
+#define WDT_CAUSE_DEADLINE		1
+
+/**
+ * @def WDT_CAUSE_STALL
+ * @brief The main loop stopped servicing the supervisor (task never returned).
+ */
+#define WDT_CAUSE_STALL			2
+
+/**
+ * @def WDT_SUP_VP_WORDS
+ * @brief Fault record published at WDT_SUP_VP:
+ *        resets, cause, task, time of fault in ms (high, low word).
+ */
+#define WDT_SUP_VP_WORDS		5
+
+#if WDT_SUP_ENABLE
+/**
+ * @def WDT_SUP_TICK_ISR
+ * @brief Stall detector, called from Timer2Isr every millisecond.
+ * @details Records the running scheduler task once the supervisor has not
+ *          been serviced for WDT_SUP_STALL_MS; the hardware watchdog then
+ *          resets the CPU because nothing refreshes it any more.
+ */
+#define WDT_SUP_TICK_ISR() \
+{ \
+    if (WdtSupArmed && ++WdtSupStallMs == WDT_SUP_STALL_MS && !WdtFaultRec.Pending) \
+    { \
+        WdtFaultRec.Cause = WDT_CAUSE_STALL; \
+        WdtFaultRec.Task = SchedCurrent; \
+        WdtFaultRec.Ms = SysTimCnt; \
+        WdtFaultRec.Pending = 1; \
+    } \
+}
+#else
+#define WDT_SUP_TICK_ISR()
+#endif
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief Supervisor fault record, kept in uninitialized XDATA across resets.
+ */
+typedef struct
+{
+    uint32_t Magic;            ///< WDT_FAULT_MAGIC when the record is valid.
+    uint8_t  Pending;          ///< Fault recorded, reset expected.
+    uint8_t  Cause;            ///< WDT_CAUSE_x of the last fault.
+    uint8_t  Task;             ///< Task ID of the last fault.
+    uint32_t Ms;               ///< TimeNowMs() of the last fault.
+    uint16_t Resets;           ///< Supervisor resets since power-up.
+} WdtFault;
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+/** @brief Fault record, not cleared by the startup code. */
+extern WdtFault xdata WdtFaultRec;
+
+/** @brief Stall detector is running. */
+extern uint8_t data WdtSupArmed;
+
+/** @brief Milliseconds since the supervisor was last serviced. */
+extern uint16_t xdata WdtSupStallMs;
 
 //==============================================================================
 //--------------------------------PROTOTYPE-------------------------------------
@@ -58,6 +147,36 @@ void WDTStop(void);
  */
 void WDTRefresh(void);
 
+#if WDT_SUP_ENABLE
+/**
+ * @brief Publishes the fault record left by a supervisor reset and clears the task table.
+ */
+void WdtSupInit(void);
+
+/**
+ * @brief Registers a task that must check in periodically.
+ * @param Task ID recorded when it misses its deadline (scheduler task ID).
+ * @param DeadlineMs Longest allowed time between check-ins.
+ * @return uint8_t Handle for WdtSupCheckIn(), WDT_SUP_NONE if the table is full.
+ */
+uint8_t WdtSupRegister(uint8_t Task, uint16_t DeadlineMs);
+
+/**
+ * @brief Reports a task as alive.
+ * @param Id Handle from WdtSupRegister().
+ */
+void WdtSupCheckIn(uint8_t Id);
+
+/**
+ * @brief Starts the hardware watchdog and the periodic service.
+ */
+void WdtSupStart(void);
+#else
+#define WdtSupInit()
+#define WdtSupCheckIn(Id)
+#define WdtSupStart()
+#endif
+
 //==============================================================================
 //---------------------------------END FILE-------------------------------------
 //==============================================================================
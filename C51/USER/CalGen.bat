@@ -0,0 +1,5 @@
+@echo off
+rem Regenerates the factory ADC calibration tables before the build.
+rem CalGen.exe is built from TOOLS\CAL_GEN\CalGen.c; without it the checked-in CalTable.c is used.
+if not exist ..\..\TOOLS\CAL_GEN\CalGen.exe exit /b 0
+..\..\TOOLS\CAL_GEN\CalGen.exe -o ..\HANDWARE\CALIB\CalTable.c ..\..\TOOLS\CAL_GEN\Calibration.csv
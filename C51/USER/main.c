@@ -32,6 +32,8 @@ SOFTWARE.
 //==============================================================================
 #include "SYSTEM.h"
 #include "APP.h"
+#include "SCHEDULER.h"
+#include "DIAG.h"
 //==============================================================================
 //---------------------------------Defines--------------------------------------
 //==============================================================================
@@ -68,7 +70,7 @@ void main(void)
 	
   while(1)
   { 
-		AppProcess();
+		DiagLoop(SchedRun());	//Run the highest-priority ready task, account the pass
 	}
 }
 
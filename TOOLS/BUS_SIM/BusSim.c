@@ -0,0 +1,712 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file BusSim.c
+ * @brief Host pin-level model of the bit-banged SPI and I2C masters.
+ *
+ * Compiles C51/HANDWARE/SPI/SPI.c, C51/HANDWARE/I2C/I2C.c and
+ * C51/HANDWARE/GPIO/GPIO.c unchanged for the host against the stand-in
+ * HOST/GPIO.h, whose pin macros and port latches land in the pin model
+ * below; push-pull pins follow the PxMDOUT bits written by InitGpio(). Every level change is passed to two slave models that
+ * decode the bus from the edges alone and check the waveform rules:
+ *
+ * SPI slave (modes 0-3): SCK at the CPOL level when CS falls and rises,
+ * MOSI changing only in the half period where it is not sampled, whole
+ * bytes per selection, and the data seen by both ends.
+ *
+ * I2C slave (24C02-like EEPROM at 0x50): SDA changing while SCL is high
+ * only as START/STOP, the START/repeated START/STOP sequence of each
+ * transaction, ACK/NACK, page write and random read, clock stretching,
+ * stretch timeout, a NACKed address and recovery of a bus left stuck by a
+ * reset. SCL and SDA are wired-AND with the pull-ups and must stay
+ * open-drain.
+ *
+ * Port latch vs pin: an input held low from outside while GPIO.c updates
+ * another pin of its port must still read high once released, i.e. port
+ * writes change the latches and never copy a pin level into one.
+ *
+ * Prints pin accesses per bit (the bit-bang cost, independent of the
+ * host) and, with a file argument, writes the waveforms as a VCD file.
+ * SCK and SCL rates on the target come from SpiBench() and I2cBench().
+ * Exits non-zero if any check fails.
+ *
+ * Build (from this directory; GPIO.c is copied so that its "GPIO.h" is the
+ * stand-in; both masters ship disabled and are enabled here):
+ *   cp ../../C51/HANDWARE/GPIO/GPIO.c GpioFw.c
+ *   cc -O2 -DSPI_ENABLE=1 -DI2C_ENABLE=1 -I../HOST -I../../C51/HANDWARE/SYSTEM
+ *      -I../../C51/HANDWARE/SPI -I../../C51/HANDWARE/I2C -o BusSim BusSim.c GpioFw.c
+ *      ../../C51/HANDWARE/SPI/SPI.c ../../C51/HANDWARE/I2C/I2C.c
+ * Run: ./BusSim [waves.vcd]
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdio.h>
+#include <string.h>
+#include "SYSTEM.h"
+#include "GPIO.h"
+#include "SPI.h"
+#include "I2C.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define PIN_ID(Pin)         PIN_ID_(Pin)
+#define PIN_ID_(Port, Pin)  ((Port) * 8 + (Pin))
+
+#define SIM_CS_PIN          GPIO_PORT_1, GPIO_PIN_4     ///< Chip select of the simulated SPI slave.
+#define SIM_IN_PIN          GPIO_PORT_1, GPIO_PIN_0     ///< Input held low from outside by the latch test.
+#define SIM_OUT_PIN         GPIO_PORT_1, GPIO_PIN_2     ///< Output the latch test toggles meanwhile.
+
+#define SCK                 PIN_ID(SPI_SCK_PIN)
+#define MOSI                PIN_ID(SPI_MOSI_PIN)
+#define MISO                PIN_ID(SPI_MISO_PIN)
+#define CS                  PIN_ID(SIM_CS_PIN)
+#define SCL                 PIN_ID(I2C_SCL_PIN)
+#define SDA                 PIN_ID(I2C_SDA_PIN)
+#define IN                  PIN_ID(SIM_IN_PIN)
+#define OUT                 PIN_ID(SIM_OUT_PIN)
+
+#define PINS                32
+#define SPI_TX_LEN          9       ///< Bytes the SPI slave answers with.
+#define SPI_RX_MAX          64
+#define EE_SLAVE            0x50    ///< 7-bit address of the EEPROM model.
+#define EE_PAGE             8       ///< EEPROM page size (pointer wraps inside a page on write).
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+uint8_t EA = 1;
+uint8_t P0MDOUT, P1MDOUT, P2MDOUT, P3MDOUT;     ///< Bit set = push-pull (InitGpio).
+static uint8_t Latch[PINS];         ///< Master output latches.
+static uint8_t Hold[PINS];          ///< 1 = pulled low from outside (open-drain inputs).
+static uint8_t Level[PINS];         ///< Line levels.
+static uint32_t Step;               ///< Pin accesses so far, the model's time base.
+static uint32_t Writes;             ///< Master pin writes so far.
+static FILE *Vcd;
+static int Failed = 0;
+
+/**
+ * @brief SPI slave model.
+ */
+static struct
+{
+    uint8_t Mode;                   ///< Mode the slave expects.
+    uint8_t Selected;
+    uint8_t Miso;                   ///< Slave output.
+    uint32_t Bits;                  ///< Bits sampled in this selection.
+    uint8_t Shift;
+    uint8_t Rx[SPI_RX_MAX];         ///< Bytes received from MOSI.
+    uint8_t RxLen;
+    uint8_t Tx[SPI_TX_LEN];         ///< Bytes sent on MISO.
+    uint32_t Errors;
+} Spi;
+
+/**
+ * @brief I2C EEPROM model states.
+ */
+typedef enum
+{
+    EE_IDLE,                        ///< Waiting for START.
+    EE_ADDR,                        ///< Receiving the address byte.
+    EE_WRITE,                       ///< Receiving word address and data.
+    EE_READ,                        ///< Sending data.
+    EE_WAIT,                        ///< NACKed, waiting for START or STOP.
+} EeState;
+
+/**
+ * @brief I2C slave model.
+ */
+static struct
+{
+    EeState State;
+    uint8_t Bits;                   ///< SCL rising edges in this byte.
+    uint8_t AckPhase;               ///< In the 9th clock.
+    uint8_t Shift;
+    uint8_t Read;                   ///< R/W bit of the address byte.
+    uint8_t HavePtr;                ///< Word address received in this write.
+    uint8_t Ptr;
+    uint8_t MasterAck;
+    uint8_t Sda;                    ///< Slave SDA output, 1 = released.
+    uint32_t Stretch;               ///< Master reads of SCL left before the slave releases it.
+    uint32_t StretchPolls;          ///< Stretch applied after every acknowledge clock.
+    uint8_t Mem[256];
+    char Trace[64];                 ///< S = START, R = repeated START, P = STOP.
+    uint8_t TraceLen;
+    uint32_t Acks, Nacks;           ///< Master acknowledges of read bytes.
+    uint32_t Errors;
+} Ee;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Reports a failed check.
+ */
+static void Fail(const char *what, uint32_t got, uint32_t want)
+{
+    printf("FAIL %-40s got 0x%X want 0x%X\n", what, got, want);
+    Failed = 1;
+}
+
+/**
+ * @brief Compares a result with the expected value.
+ */
+static void Expect(const char *what, uint32_t got, uint32_t want)
+{
+    if (got != want) Fail(what, got, want);
+}
+
+/**
+ * @brief Bit k of the SPI slave answer, MSB first.
+ */
+static uint8_t SpiTxBit(uint32_t k)
+{
+    return (Spi.Tx[(k / 8) % SPI_TX_LEN] >> (7 - k % 8)) & 1;
+}
+
+/**
+ * @brief SPI slave: one edge on SCK, MOSI or CS.
+ */
+static void SpiEdge(uint8_t Id, uint8_t New)
+{
+    uint8_t cpol = Spi.Mode >> 1, cpha = Spi.Mode & 1;
+    uint8_t leading;
+
+    if (Id == CS)
+    {
+        if (!New)
+        {
+            if (Level[SCK] != cpol) Spi.Errors++;        //SCK not idle at select
+            Spi.Selected = 1;
+            Spi.Bits = 0;
+            Spi.RxLen = 0;
+            if (!cpha) Spi.Miso = SpiTxBit(0);
+        }
+        else
+        {
+            if (Level[SCK] != cpol || Spi.Bits % 8) Spi.Errors++;   //SCK not idle or partial byte
+            Spi.Selected = 0;
+            Spi.Miso = 1;
+        }
+        return;
+    }
+    if (!Spi.Selected) return;
+    if (Id == MOSI)
+    {
+        //Must not move in the half period ending with the sampling edge
+        if ((Level[SCK] != cpol) == !cpha) Spi.Errors++;
+        return;
+    }
+    if (Id != SCK) return;
+    leading = (New != cpol);
+    if (leading == !cpha)
+    {
+        Spi.Shift = (uint8_t)((Spi.Shift << 1) | Level[MOSI]);
+        Spi.Bits++;
+        if (Spi.Bits % 8 == 0 && Spi.RxLen < SPI_RX_MAX) Spi.Rx[Spi.RxLen++] = Spi.Shift;
+    }
+    else
+    {
+        Spi.Miso = SpiTxBit(Spi.Bits);
+    }
+}
+
+/**
+ * @brief I2C slave: drives SDA with bit 7 - Bits of the byte being read.
+ */
+static void EeDriveBit(void)
+{
+    Ee.Sda = (Ee.Shift >> (7 - Ee.Bits)) & 1;
+}
+
+/**
+ * @brief I2C slave: one edge on SCL or SDA.
+ */
+static void EeEdge(uint8_t Id, uint8_t New)
+{
+    if (Id == SDA)
+    {
+        if (!Level[SCL]) return;                    //Data change, SCL low: fine
+        //START/STOP inside a byte; the clock that carries one counts as a first bit
+        if ((Ee.State == EE_ADDR || Ee.State == EE_WRITE || Ee.State == EE_READ) && (Ee.Bits > 1 || Ee.AckPhase))
+        {
+            Ee.Errors++;
+        }
+        if (Ee.TraceLen < sizeof(Ee.Trace) - 1)
+        {
+            Ee.Trace[Ee.TraceLen++] = New ? 'P' : (Ee.State == EE_IDLE ? 'S' : 'R');
+        }
+        Ee.State = New ? EE_IDLE : EE_ADDR;
+        Ee.Bits = 0;
+        Ee.AckPhase = 0;
+        Ee.HavePtr = 0;
+        Ee.Sda = 1;
+        return;
+    }
+    if (Id != SCL) return;
+
+    if (New)
+    {
+        //Rising edge: sample
+        if (Ee.AckPhase)
+        {
+            if (Ee.State == EE_READ)
+            {
+                Ee.MasterAck = !Level[SDA];
+                if (Ee.MasterAck) Ee.Acks++;
+                else Ee.Nacks++;
+            }
+        }
+        else if (Ee.State == EE_ADDR || Ee.State == EE_WRITE)
+        {
+            Ee.Shift = (uint8_t)((Ee.Shift << 1) | Level[SDA]);
+            Ee.Bits++;
+        }
+        else if (Ee.State == EE_READ)
+        {
+            Ee.Bits++;
+        }
+        return;
+    }
+
+    //Falling edge: drive
+    if (Ee.AckPhase)
+    {
+        Ee.AckPhase = 0;
+        Ee.Bits = 0;
+        Ee.Sda = 1;
+        if (Ee.State == EE_ADDR)
+        {
+            Ee.State = Ee.Read ? EE_READ : EE_WRITE;
+            if (Ee.Read)
+            {
+                Ee.Shift = Ee.Mem[Ee.Ptr];
+                EeDriveBit();
+            }
+        }
+        else if (Ee.State == EE_READ)
+        {
+            if (Ee.MasterAck)
+            {
+                Ee.Ptr++;
+                Ee.Shift = Ee.Mem[Ee.Ptr];
+                EeDriveBit();
+            }
+            else
+            {
+                Ee.Ptr++;
+                Ee.State = EE_WAIT;
+            }
+        }
+        Ee.Stretch = Ee.StretchPolls;
+        return;
+    }
+    if (Ee.Bits < 8)
+    {
+        if (Ee.State == EE_READ) EeDriveBit();
+        return;
+    }
+    //Eighth bit done
+    Ee.AckPhase = 1;
+    if (Ee.State == EE_ADDR)
+    {
+        if ((Ee.Shift >> 1) != EE_SLAVE)
+        {
+            Ee.State = EE_WAIT;
+            Ee.AckPhase = 0;
+            return;
+        }
+        Ee.Read = Ee.Shift & 1;
+        Ee.Sda = 0;
+    }
+    else if (Ee.State == EE_WRITE)
+    {
+        if (!Ee.HavePtr)
+        {
+            Ee.Ptr = Ee.Shift;
+            Ee.HavePtr = 1;
+        }
+        else
+        {
+            Ee.Mem[Ee.Ptr] = Ee.Shift;
+            Ee.Ptr = (uint8_t)((Ee.Ptr & ~(EE_PAGE - 1)) | ((Ee.Ptr + 1) & (EE_PAGE - 1)));
+        }
+        Ee.Sda = 0;
+    }
+    else if (Ee.State == EE_READ)
+    {
+        Ee.Sda = 1;                                 //Release for the master acknowledge
+    }
+}
+
+/**
+ * @brief 1 if the pin is push-pull, from its PxMDOUT bit.
+ */
+static uint8_t PushPull(uint8_t Id)
+{
+    static uint8_t *const mdout[4] = {&P0MDOUT, &P1MDOUT, &P2MDOUT, &P3MDOUT};
+
+    return (*mdout[Id / 8] >> (Id % 8)) & 1;
+}
+
+/**
+ * @brief Level a line settles to from the master latch and the slaves.
+ */
+static uint8_t LineLevel(uint8_t Id)
+{
+    if (Id == MISO) return Spi.Selected ? Spi.Miso : 1;
+    if (Id == SCL) return Latch[Id] && !Ee.Stretch;
+    if (Id == SDA) return Latch[Id] && Ee.Sda;
+    return Latch[Id] && !Hold[Id];
+}
+
+/**
+ * @brief Applies line changes one at a time until the bus is stable.
+ */
+static void Settle(void)
+{
+    uint8_t id, lv, changed;
+
+    do
+    {
+        changed = 0;
+        for (id = 0; id < PINS; id++)
+        {
+            lv = LineLevel(id);
+            if (lv == Level[id]) continue;
+            Level[id] = lv;
+            if (Vcd) fprintf(Vcd, "#%u\n%u%c\n", Step, lv, '!' + id);
+            SpiEdge(id, lv);
+            EeEdge(id, lv);
+            changed = 1;
+            break;
+        }
+    } while (changed);
+}
+
+/**
+ * @brief Pin write from the drivers (GPIO_SET/CLR/WRITE).
+ */
+void GpioSimWrite(uint8_t Port, uint8_t Pin, uint8_t Level)
+{
+    uint8_t id = Port * 8 + Pin;
+
+    Step++;
+    Writes++;
+    if ((id == SCL || id == SDA) && PushPull(id))
+    {
+        Fail("I2C line driven push-pull", id, 0);
+    }
+    Latch[id] = Level ? 1 : 0;
+    Settle();
+}
+
+/**
+ * @brief Latch read-modify-write of a whole port (GPIO_LATCH_CLR/SET in GPIO.c).
+ */
+void GpioSimLatch(uint8_t Port, uint8_t Bits, uint8_t Level)
+{
+    uint8_t pin, id;
+
+    Step++;
+    Writes++;
+    for (pin = 0; pin < 8; pin++)
+    {
+        if (!(Bits & (1 << pin))) continue;
+        id = Port * 8 + pin;
+        if ((id == SCL || id == SDA) && PushPull(id) && Latch[id] != Level)
+        {
+            Fail("I2C line driven push-pull", id, 0);
+        }
+        Latch[id] = Level;
+    }
+    Settle();
+}
+
+/**
+ * @brief Pin read from the drivers (GPIO_READ); a stretching slave lets go after Stretch reads.
+ */
+uint8_t GpioSimRead(uint8_t Port, uint8_t Pin)
+{
+    uint8_t id = Port * 8 + Pin;
+
+    Step++;
+    if (id == SCL && Ee.Stretch && --Ee.Stretch == 0) Settle();
+    return Level[id];
+}
+
+/**
+ * @brief Port read (P0..P3 in GPIO.c): the pin levels, not the latches.
+ */
+uint8_t GpioSimPort(uint8_t Port)
+{
+    uint8_t pin, v = 0;
+
+    Step++;
+    for (pin = 0; pin < 8; pin++) v |= (uint8_t)(Level[Port * 8 + pin] << pin);
+    return v;
+}
+
+/**
+ * @brief Runs one SPI transaction with the master in MasterMode and the slave in SlaveMode.
+ * @return int 0 if data and waveform checks passed.
+ */
+static int SpiRun(uint8_t MasterMode, uint8_t SlaveMode, int Report)
+{
+    static const uint8_t tx[4] = {0xA5, 0x3C, 0x00, 0xFF};
+    SpiDevice dev = {SIM_CS_PIN, 0};
+    uint8_t rx[4], x, i;
+    uint32_t w;
+    int bad = 0;
+
+    dev.Mode = MasterMode;
+    for (i = 0; i < SPI_TX_LEN; i++) Spi.Tx[i] = (uint8_t)(0x81 + i * 0x1D);
+    Spi.Mode = SlaveMode;
+    Spi.Errors = 0;
+    SpiAttach(&dev);
+    SpiBegin(&dev);
+    w = Writes;
+    SpiWrite(tx, 4);
+    w = Writes - w;
+    SpiRead(rx, 4);
+    x = SpiTransfer(0x5A);
+    SpiEnd();
+
+    bad |= Spi.Errors != 0;
+    bad |= Spi.RxLen != 9 || memcmp(Spi.Rx, tx, 4) != 0;
+    for (i = 4; i < 8; i++) bad |= Spi.Rx[i] != SPI_FILL;
+    bad |= Spi.Rx[8] != 0x5A;
+    bad |= memcmp(rx, &Spi.Tx[4], 4) != 0 || x != Spi.Tx[8];
+    if (Report)
+    {
+        Expect("SPI waveform errors", Spi.Errors, 0);
+        Expect("SPI bytes seen by slave", Spi.RxLen, 9);
+        Expect("SPI MOSI data", memcmp(Spi.Rx, tx, 4) == 0, 1);
+        Expect("SPI fill bytes / transfer", Spi.Rx[4] == SPI_FILL && Spi.Rx[8] == 0x5A, 1);
+        Expect("SPI MISO data", memcmp(rx, &Spi.Tx[4], 4) == 0 && x == Spi.Tx[8], 1);
+        printf("SPI mode %u: %s, %.1f pin writes per bit\n", MasterMode, bad ? "FAIL" : "ok", w / 32.0);
+    }
+    return bad;
+}
+
+/**
+ * @brief Clears the I2C event trace.
+ */
+static void EeClear(void)
+{
+    Ee.TraceLen = 0;
+    Ee.Trace[0] = 0;
+    Ee.Acks = Ee.Nacks = 0;
+    Ee.Errors = 0;
+}
+
+/**
+ * @brief Checks the trace of the last transaction.
+ */
+static void EeExpectTrace(const char *what, const char *want)
+{
+    Ee.Trace[Ee.TraceLen] = 0;
+    if (strcmp(Ee.Trace, want) != 0)
+    {
+        printf("FAIL %-40s got %s want %s\n", what, Ee.Trace, want);
+        Failed = 1;
+    }
+    Expect(what, Ee.Errors, 0);
+}
+
+/**
+ * @brief I2C transactions against the EEPROM model.
+ */
+static void I2cRun(void)
+{
+    uint8_t out[1 + EE_PAGE], in[EE_PAGE], i;
+    uint32_t w;
+
+    memset(&Ee, 0, sizeof(Ee));
+    Ee.Sda = 1;
+    Settle();
+    Expect("I2cInit idle bus", I2cInit(), I2C_OK);
+    Expect("SCL open-drain", PushPull(SCL), 0);
+    Expect("SDA open-drain", PushPull(SDA), 0);
+
+    //Page write, then random read with a repeated START
+    out[0] = 0x10;
+    for (i = 0; i < EE_PAGE; i++) out[1 + i] = (uint8_t)(0xC3 ^ (i * 0x25));
+    EeClear();
+    w = Writes;
+    Expect("page write", I2cWriteRead(EE_SLAVE, out, sizeof(out), 0, 0), I2C_OK);
+    w = Writes - w;
+    EeExpectTrace("page write START/STOP", "SP");
+    Expect("page write data", memcmp(&Ee.Mem[0x10], &out[1], EE_PAGE) == 0, 1);
+
+    EeClear();
+    Expect("random read", I2cWriteRead(EE_SLAVE, out, 1, in, EE_PAGE), I2C_OK);
+    EeExpectTrace("random read START/Sr/STOP", "SRP");
+    Expect("random read data", memcmp(in, &out[1], EE_PAGE) == 0, 1);
+    Expect("master ACKs", Ee.Acks, EE_PAGE - 1);
+    Expect("master NACK on last byte", Ee.Nacks, 1);
+    printf("I2C: %.1f pin writes per bit\n", w / (9.0 * sizeof(out) + 9.0));
+
+    //Split transaction on the primitives, bus held across the calls
+    EeClear();
+    Expect("I2cStart write", I2cStart(EE_SLAVE, 0), I2C_OK);
+    Expect("I2cWrite pointer", I2cWrite(out, 1), I2C_OK);
+    Expect("I2cStart read", I2cStart(EE_SLAVE, 1), I2C_OK);
+    Expect("I2cRead head", I2cRead(in, 3, 0), I2C_OK);
+    Expect("I2cRead tail", I2cRead(&in[3], EE_PAGE - 3, 1), I2C_OK);
+    I2cStop();
+    EeExpectTrace("split read START/Sr/STOP", "SRP");
+    Expect("split read data", memcmp(in, &out[1], EE_PAGE) == 0, 1);
+
+    //No device at the address
+    EeClear();
+    Expect("absent address", I2cWriteRead(EE_SLAVE + 1, out, 1, in, 1), I2C_NACK);
+    EeExpectTrace("absent address START/STOP", "SP");
+
+    //Clock stretching after every acknowledge
+    EeClear();
+    Ee.StretchPolls = 200;
+    memset(in, 0, sizeof(in));
+    Expect("stretched read", I2cWriteRead(EE_SLAVE, out, 1, in, EE_PAGE), I2C_OK);
+    EeExpectTrace("stretched read START/Sr/STOP", "SRP");
+    Expect("stretched read data", memcmp(in, &out[1], EE_PAGE) == 0, 1);
+
+    //A slave that never lets go
+    EeClear();
+    Ee.StretchPolls = 0xFFFFFFFFUL;
+    Expect("stretch timeout", I2cWriteRead(EE_SLAVE, out, 1, in, 1), I2C_TIMEOUT);
+    Ee.StretchPolls = 0;
+    Ee.Stretch = 0;
+    Ee.State = EE_IDLE;
+    Settle();
+
+    //Reset left the slave driving a 0 mid-byte of a read
+    Ee.State = EE_READ;
+    Ee.Shift = 0x00;
+    Ee.Bits = 4;
+    Ee.Sda = 0;
+    Settle();
+    EeClear();
+    Expect("I2cInit stuck bus", I2cInit(), I2C_OK);
+    Expect("stuck bus released", Level[SDA], 1);
+    EeClear();
+    Expect("read after recovery", I2cWriteRead(EE_SLAVE, out, 1, in, 1), I2C_OK);
+    EeExpectTrace("read after recovery START/Sr/STOP", "SRP");
+}
+
+/**
+ * @brief Port writes of GPIO.c while another pin of the port is held low.
+ */
+static void GpioLatchRun(void)
+{
+    EPinState st;
+
+    Expect("InitGpio input", InitGpio(GPIO_IN, SIM_IN_PIN, GPIO_LOW), GPIO_OK);
+    Expect("InitGpio output", InitGpio(GPIO_OUT, SIM_OUT_PIN, GPIO_LOW), GPIO_OK);
+    Expect("output push-pull", PushPull(OUT), 1);
+    Expect("input open-drain", PushPull(IN), 0);
+
+    Hold[IN] = 1;
+    Settle();
+    GetGpioState(SIM_IN_PIN, &st);
+    Expect("held input reads low", st, GPIO_LOW);
+    SetGpioOutState(SIM_OUT_PIN, GPIO_HIGHT);
+    Expect("output high", Level[OUT], 1);
+    SetGpioOutState(SIM_OUT_PIN, GPIO_LOW);
+    Expect("output low", Level[OUT], 0);
+    GpioPortMask(GPIO_PORT_1, 1 << GPIO_PIN_2, 0xFF);
+    Expect("port mask output high", Level[OUT], 1);
+    InitGpio(GPIO_OUT, SIM_OUT_PIN, GPIO_LOW);
+    Expect("re-init output low", Level[OUT], 0);
+
+    Hold[IN] = 0;
+    Settle();
+    Expect("input latch kept high", Latch[IN], 1);
+    GetGpioState(SIM_IN_PIN, &st);
+    Expect("released input reads high", st, GPIO_HIGHT);
+    printf("GPIO: port writes keep the latches of held inputs: %s\n", Failed ? "FAIL" : "ok");
+}
+
+/**
+ * @brief Writes the VCD header for the bus lines; one time unit is one pin access.
+ */
+static void VcdHeader(void)
+{
+    static const char *names[6] = {"SCK", "MOSI", "MISO", "CS", "SCL", "SDA"};
+    uint8_t ids[6] = {SCK, MOSI, MISO, CS, SCL, SDA};
+    int i;
+
+    fprintf(Vcd, "$timescale 1ns $end\n$scope module bus $end\n");
+    for (i = 0; i < 6; i++) fprintf(Vcd, "$var wire 1 %c %s $end\n", '!' + ids[i], names[i]);
+    fprintf(Vcd, "$upscope $end\n$enddefinitions $end\n#0\n");
+    for (i = 0; i < 6; i++) fprintf(Vcd, "1%c\n", '!' + ids[i]);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t m;
+
+    if (argc > 1)
+    {
+        Vcd = fopen(argv[1], "w");
+        if (!Vcd)
+        {
+            perror(argv[1]);
+            return 2;
+        }
+        VcdHeader();
+    }
+    memset(Level, 1, sizeof(Level));
+    memset(Latch, 1, sizeof(Latch));
+    Ee.Sda = 1;
+
+    SpiInit();
+    for (m = SPI_MODE_0; m <= SPI_MODE_3; m++) SpiRun(m, m, 1);
+    //The model must reject a master in the wrong mode
+    for (m = SPI_MODE_0; m <= SPI_MODE_3; m++)
+    {
+        if (!SpiRun(m, m ^ 1, 0)) Fail("SPI mode mismatch not detected", m, m ^ 1);
+    }
+
+    I2cRun();
+    GpioLatchRun();
+
+    if (Vcd) fclose(Vcd);
+    printf("I2C_DELAY %d, I2C_STRETCH_MAX %d: %s\n", I2C_DELAY, I2C_STRETCH_MAX, Failed ? "FAIL" : "all checks passed");
+    return Failed;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
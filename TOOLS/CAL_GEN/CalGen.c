@@ -0,0 +1,263 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file CalGen.c
+ * @brief Generates the factory ADC calibration tables (CalTable.c) from a CSV.
+ *
+ * Input, one calibration point per line (blank lines, '#' comments and one
+ * non-numeric header line before the data are skipped):
+ *   channel,raw,value
+ * channel is 1 to 7, raw the ADC counts (0 to 65535) and value the
+ * engineering value (-32768 to 32767) in whatever unit and scale the channel
+ * uses. Points may come in any order; per channel raw must not repeat, at
+ * least two points are needed and neighbouring values may differ by at most
+ * 32767. Segment slopes are computed here with the same Q16 arithmetic as
+ * CalLoadVp(), so CalConvert() never divides.
+ *
+ * Usage: CalGen [-o CalTable.c] Calibration.csv
+ * Keil runs it before each build through USER/CalGen.bat when CalGen.exe
+ * has been built next to this file.
+ *
+ * Build (from this directory): cc -O2 -Wall -o CalGen CalGen.c
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define CHANNELS        7       ///< ADC_CHANNELS of the firmware.
+#define POINTS_MAX      255     ///< CalCurve.Count is a uint8_t.
+
+/**
+ * @brief One calibration point.
+ */
+typedef struct
+{
+    long Raw;
+    long Value;
+} Point;
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+static Point Points[CHANNELS][POINTS_MAX];
+static int Count[CHANNELS];
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Orders points by raw counts.
+ */
+static int CmpRaw(const void* a, const void* b)
+{
+    long d = ((const Point*)a)->Raw - ((const Point*)b)->Raw;
+    return (d > 0) - (d < 0);
+}
+
+/**
+ * @brief Reads the CSV; returns 0 on success.
+ */
+static int ReadCsv(const char* name)
+{
+    FILE* f = fopen(name, "r");
+    char line[256];
+    long ch, raw, value;
+    int n = 0;
+    int data = 0;
+    char* s;
+
+    if (!f)
+    {
+        perror(name);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f))
+    {
+        n++;
+        s = line + strspn(line, " \t");
+        if (*s == '#' || *s == '\r' || *s == '\n' || *s == 0) continue;
+        if (sscanf(s, "%ld ,%ld ,%ld", &ch, &raw, &value) != 3)
+        {
+            if (!data++) continue;  //Header
+            fprintf(stderr, "%s:%d: expected channel,raw,value\n", name, n);
+            fclose(f);
+            return 1;
+        }
+        data = 1;
+        if (ch < 1 || ch > CHANNELS || raw < 0 || raw > 65535 || value < -32768 || value > 32767)
+        {
+            fprintf(stderr, "%s:%d: value out of range\n", name, n);
+            fclose(f);
+            return 1;
+        }
+        if (Count[ch - 1] == POINTS_MAX)
+        {
+            fprintf(stderr, "%s:%d: more than %d points on channel %ld\n", name, n, POINTS_MAX, ch);
+            fclose(f);
+            return 1;
+        }
+        Points[ch - 1][Count[ch - 1]].Raw = raw;
+        Points[ch - 1][Count[ch - 1]].Value = value;
+        Count[ch - 1]++;
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @brief Sorts and checks every channel; returns 0 on success.
+ */
+static int CheckCurves(void)
+{
+    int ch, i;
+
+    for (ch = 0; ch < CHANNELS; ch++)
+    {
+        if (Count[ch] == 0) continue;
+        if (Count[ch] == 1)
+        {
+            fprintf(stderr, "channel %d: a curve needs at least two points\n", ch + 1);
+            return 1;
+        }
+        qsort(Points[ch], Count[ch], sizeof(Point), CmpRaw);
+        for (i = 1; i < Count[ch]; i++)
+        {
+            if (Points[ch][i].Raw == Points[ch][i - 1].Raw)
+            {
+                fprintf(stderr, "channel %d: raw %ld appears twice\n", ch + 1, Points[ch][i].Raw);
+                return 1;
+            }
+            if (labs(Points[ch][i].Value - Points[ch][i - 1].Value) > 32767)
+            {
+                fprintf(stderr, "channel %d: step at raw %ld exceeds 32767, add a point\n", ch + 1, Points[ch][i].Raw);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes CalTable.c; returns 0 on success.
+ */
+static int WriteTable(const char* name, const char* csv)
+{
+    FILE* f = fopen(name, "w");
+    int32_t slope, dv;
+    int ch, i;
+
+    if (!f)
+    {
+        perror(name);
+        return 1;
+    }
+    fprintf(f, "/**\n");
+    fprintf(f, " * @file CalTable.c\n");
+    fprintf(f, " * @brief Factory ADC calibration curves in CODE.\n");
+    fprintf(f, " * @details Generated by TOOLS/CAL_GEN/CalGen from %s; edit the CSV, not this file.\n", csv);
+    fprintf(f, " *          Columns: Raw, Value, Slope (dValue/dRaw in Q16 up to the next point).\n");
+    fprintf(f, " */\n\n");
+    fprintf(f, "//==============================================================================\n");
+    fprintf(f, "//---------------------------------Includes-------------------------------------\n");
+    fprintf(f, "//==============================================================================\n");
+    fprintf(f, "#include \"CALIB.h\"\n\n");
+    fprintf(f, "//==============================================================================\n");
+    fprintf(f, "//---------------------------------VARIABLES------------------------------------\n");
+    fprintf(f, "//==============================================================================\n");
+    for (ch = 0; ch < CHANNELS; ch++)
+    {
+        if (Count[ch] == 0) continue;
+        fprintf(f, "static code CalPoint CalCh%d[%d] =\n{\n", ch + 1, Count[ch]);
+        for (i = 0; i < Count[ch]; i++)
+        {
+            slope = 0;
+            if (i + 1 < Count[ch])
+            {
+                //Same arithmetic as CalLoadVp(): int32_t, truncated toward zero
+                dv = (int32_t)(Points[ch][i + 1].Value - Points[ch][i].Value);
+                slope = (dv * 65536L) / (int32_t)(Points[ch][i + 1].Raw - Points[ch][i].Raw);
+            }
+            fprintf(f, "    { %5ld, %6ld, %11ldL },\n", Points[ch][i].Raw, Points[ch][i].Value, (long)slope);
+        }
+        fprintf(f, "};\n\n");
+    }
+    fprintf(f, "code CalCurve CalDefault[ADC_CHANNELS] =\n{\n");
+    for (ch = 0; ch < CHANNELS; ch++)
+    {
+        if (Count[ch]) fprintf(f, "    { CalCh%d, %d },\n", ch + 1, Count[ch]);
+        else fprintf(f, "    { 0, 0 },          ///< Channel %d uncalibrated: raw counts.\n", ch + 1);
+    }
+    fprintf(f, "};\n\n");
+    fprintf(f, "//==============================================================================\n");
+    fprintf(f, "//---------------------------------END FILE-------------------------------------\n");
+    fprintf(f, "//==============================================================================\n");
+    return fclose(f) != 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* out = "CalTable.c";
+    const char* csv;
+    const char* base;
+
+    if (argc == 4 && strcmp(argv[1], "-o") == 0)
+    {
+        out = argv[2];
+        csv = argv[3];
+    }
+    else if (argc == 2)
+    {
+        csv = argv[1];
+    }
+    else
+    {
+        fprintf(stderr, "usage: %s [-o CalTable.c] Calibration.csv\n", argv[0]);
+        return 2;
+    }
+    if (ReadCsv(csv) || CheckCurves()) return 1;
+
+    base = strrchr(csv, '/');
+    if (!base) base = strrchr(csv, '\\');
+    return WriteTable(out, base ? base + 1 : csv);
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
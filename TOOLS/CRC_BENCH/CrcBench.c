@@ -0,0 +1,226 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file CrcBench.c
+ * @brief Host benchmark of the firmware checksum engine.
+ *
+ * Compiles C51/HANDWARE/UART/CRC16.c and C51/HANDWARE/CHECKSUM/CHECKSUM.c
+ * unchanged for the host, checks every algorithm against its catalogue
+ * check value, checks that chunked, ring and DGUS updates give the same
+ * result as one block, and prints the cost of each variant in host
+ * cycles per byte and bytes per cycle. The numbers rank the variants;
+ * absolute 8051 figures come from Crc16Bench() on the target.
+ *
+ * CRC16_MODE is chosen at compile time, so the build makes one binary per
+ * mode and the run goes through all three (the table in CRC16.h comes
+ * from these runs).
+ *
+ * Build (from this directory):
+ *   for m in 0 1 2; do cc -O2 -DCRC16_MODE=$m -I../HOST
+ *      -I../../C51/HANDWARE/SYSTEM -I../../C51/HANDWARE/UART
+ *      -I../../C51/HANDWARE/CHECKSUM -o CrcBench$m CrcBench.c
+ *      ../../C51/HANDWARE/UART/CRC16.c ../../C51/HANDWARE/CHECKSUM/CHECKSUM.c; done
+ * Run: for m in 0 1 2; do ./CrcBench$m || break; done
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "SYSTEM.h"
+#include "CRC16.h"
+#include "CHECKSUM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define BENCH_LEN       4096    ///< Bytes per timed block.
+#define BENCH_ROUNDS    2000    ///< Timed blocks per variant.
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+static uint8_t Data[BENCH_LEN];
+static uint8_t Vp[0x20000];     ///< Fake DGUS VP space, 2 bytes per word.
+static int Failed = 0;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Host DGUS read used by ChecksumUpdateDgus().
+ */
+void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
+{
+    memcpy(pBuf, &Vp[(uint32_t)Addr * 2], (size_t)Len16 * 2);
+}
+
+void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
+{
+    memcpy(&Vp[(uint32_t)Addr * 2], pBuf, (size_t)Len16 * 2);
+}
+
+/**
+ * @brief Returns a cycle counter (TSC) or nanoseconds where there is none.
+ */
+static uint64_t Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Compares a result with the expected value.
+ */
+static void Expect(const char* what, uint32_t got, uint32_t want)
+{
+    if (got != want)
+    {
+        printf("FAIL %-28s got 0x%08X want 0x%08X\n", what, got, want);
+        Failed = 1;
+    }
+}
+
+/**
+ * @brief Checks catalogue values and the chunked, ring and DGUS paths.
+ */
+static void CheckAlgorithm(ChecksumType type, const char* name, uint32_t check)
+{
+    uint8_t ring[64];
+    Checksum ctx;
+    uint32_t whole;
+    uint16_t i, start;
+    char what[64];
+
+    snprintf(what, sizeof(what), "%s check", name);
+    Expect(what, ChecksumBlock(type, (uint8_t*)"123456789", 9), check);
+
+    whole = ChecksumBlock(type, Data, 1000);
+    ChecksumInit(&ctx, type);
+    for (i = 0; i < 1000; i += 37) ChecksumUpdate(&ctx, Data + i, (uint16_t)(1000 - i < 37 ? 1000 - i : 37));
+    snprintf(what, sizeof(what), "%s chunked", name);
+    Expect(what, ChecksumFinal(&ctx), whole);
+
+    start = 50;
+    for (i = 0; i < 40; i++) ring[(start + i) % sizeof(ring)] = Data[i];
+    ChecksumInit(&ctx, type);
+    ChecksumUpdateRing(&ctx, ring, sizeof(ring), start, 40);
+    snprintf(what, sizeof(what), "%s ring wrap", name);
+    Expect(what, ChecksumFinal(&ctx), ChecksumBlock(type, Data, 40));
+
+    WriteDgusVp(0x1000, Data, 500);
+    ChecksumInit(&ctx, type);
+    ChecksumUpdateDgus(&ctx, 0x1000, 500);
+    snprintf(what, sizeof(what), "%s dgus", name);
+    Expect(what, ChecksumFinal(&ctx), whole);
+}
+
+/**
+ * @brief Times one variant and prints its row.
+ */
+static void Bench(ChecksumType type, const char* name)
+{
+    uint64_t best = ~0ULL, t;
+    uint32_t sink = 0;
+    int r;
+    for (r = 0; r < BENCH_ROUNDS; r++)
+    {
+        t = Cycles();
+        sink += ChecksumBlock(type, Data, BENCH_LEN);
+        t = Cycles() - t;
+        if (t < best) best = t;
+    }
+    printf("%-22s %8.2f %10.4f   (0x%08X)\n", name, (double)best / BENCH_LEN, (double)BENCH_LEN / best, sink);
+}
+
+/**
+ * @brief Times the per-byte CRC16_UPDATE path used in the RX ISR.
+ */
+static void BenchStream(void)
+{
+    uint64_t best = ~0ULL, t;
+    uint16_t crc = 0;
+    uint8_t idx;
+    int r, i;
+    for (r = 0; r < BENCH_ROUNDS; r++)
+    {
+        t = Cycles();
+        crc = CRC16_INIT;
+        for (i = 0; i < BENCH_LEN; i++) CRC16_UPDATE(crc, idx, Data[i]);
+        t = Cycles() - t;
+        if (t < best) best = t;
+    }
+    printf("%-22s %8.2f %10.4f   (0x%08X)\n", "CRC16_UPDATE per byte", (double)best / BENCH_LEN, (double)BENCH_LEN / best, crc);
+}
+
+int main(void)
+{
+    int i;
+    srand(1);
+    for (i = 0; i < BENCH_LEN; i++) Data[i] = (uint8_t)rand();
+
+    CheckAlgorithm(CHECKSUM_CRC16_MODBUS, "CRC-16/Modbus", 0x4B37);
+#if CHECKSUM_CCITT_ENABLE
+    CheckAlgorithm(CHECKSUM_CRC16_CCITT, "CRC-16/CCITT", 0x29B1);
+#endif
+#if CHECKSUM_CRC32_ENABLE
+    CheckAlgorithm(CHECKSUM_CRC32, "CRC-32", 0xCBF43926UL);
+#endif
+    Expect("Crc16Table check", Crc16Table((uint8_t*)"123456789", 9), 0x4B37);
+
+    printf("CRC16_MODE %d, %d-byte blocks, best of %d\n", CRC16_MODE, BENCH_LEN, BENCH_ROUNDS);
+    printf("%-22s %8s %10s\n", "variant", "cyc/B", "B/cyc");
+    Bench(CHECKSUM_CRC16_MODBUS, "CRC-16/Modbus");
+#if CHECKSUM_CCITT_ENABLE
+    Bench(CHECKSUM_CRC16_CCITT, "CRC-16/CCITT");
+#endif
+#if CHECKSUM_CRC32_ENABLE
+    Bench(CHECKSUM_CRC32, "CRC-32");
+#endif
+    BenchStream();
+    return Failed;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,70 @@
+#ifndef __DELAY_SIM_H__
+#define __DELAY_SIM_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file DelaySim.h
+ * @brief Simulated Timer2 and core SFRs for building TIMER/Delay.c on the host.
+ *
+ * Force-included (cc -include DelaySim.h) ahead of Delay.c. Every TH2/TL2
+ * read goes to DelayTest.c, which advances a CPU cycle clock and returns the
+ * Timer2 count of that instant; the remaining SFRs are plain variables.
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdint.h>
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define TH2                 SimTH2()
+#define TL2                 SimTL2()
+#define TF2                 SimTF2()
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+extern uint8_t TR2, ET2, EA, PCON;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+uint8_t SimTH2(void);
+uint8_t SimTL2(void);
+uint8_t SimTF2(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
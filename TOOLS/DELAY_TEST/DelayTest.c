@@ -0,0 +1,281 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file DelayTest.c
+ * @brief Host accuracy test of the firmware delays against a simulated Timer2.
+ *
+ * Compiles C51/HANDWARE/TIMER/Delay.c unchanged for the host. DelaySim.h
+ * routes its TH2/TL2 reads here: a CPU cycle clock at FOSC advances by a
+ * few cycles per SFR read and, when enabled, by a random ISR of up to
+ * 100 us, and Timer2 counts FOSC/12 from T1MS to 0xFFFF and reloads every
+ * 1 ms tick like the real one. The test checks
+ *  - SysDelayUs() from 1 us to 2 s at random timer phases: never shorter
+ *    than the request, never longer by more than 10 ppm plus 1 us plus the
+ *    ISR time spent inside it;
+ *  - SysDelayMs() with the tick interrupt (at least ms full ticks, at most
+ *    one more, CPU idled between ticks) and with interrupts off;
+ *  - SysDelayMsWdtReset(): the same bounds and a watchdog refresh at least
+ *    every 1 ms.
+ * Exits non-zero if any check fails.
+ *
+ * Build (from this directory):
+ *   cc -O2 -include DelaySim.h -I../HOST -I../../C51/HANDWARE/SYSTEM
+ *      -I../../C51/HANDWARE/TIMER -I../../C51/HANDWARE/WDT
+ *      -I../../C51/HANDWARE/SCHEDULER -o DelayTest DelayTest.c
+ *      ../../C51/HANDWARE/TIMER/Delay.c
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include "SYSTEM.h"
+#include "Delay.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define CYC_PER_US      ((double)FOSC / 1e6)        ///< CPU cycles per microsecond.
+#define T2_PERIOD       (65536UL - T1MS)            ///< Timer2 counts per tick.
+#define TICK_CYC        (T2_PERIOD * 12ULL)         ///< CPU cycles per tick.
+#define ISR_MAX_US      100                         ///< Longest simulated ISR.
+#define ISR_PERMILLE    5                           ///< ISR chance per SFR read.
+#define SCALE_PPM       10.0                        ///< Allowed scaling error.
+#define PHASES          200                         ///< Random start phases per request.
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+uint8_t TR2 = 1, ET2 = 1, EA = 1, PCON = 0;        ///< Simulated SFRs (DelaySim.h).
+
+static uint64_t Cyc;                ///< CPU cycles since reset.
+static int IsrOn;                   ///< Inject ISRs.
+static uint64_t IsrCyc;             ///< ISR cycles spent in the current delay.
+static uint64_t LastWdt;            ///< Cycle of the last WDTRefresh().
+static uint64_t WdtGapMax;          ///< Longest gap between refreshes.
+static uint32_t Idles;              ///< PCON idle entries.
+static int Failed = 0;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Advances the clock by one SFR access and, maybe, an ISR.
+ */
+static void Advance(void)
+{
+    Cyc += 4 + (uint64_t)(rand() % 9);
+    if (IsrOn && rand() % 1000 < ISR_PERMILLE)
+    {
+        uint64_t isr = (uint64_t)(rand() % (int)(ISR_MAX_US * CYC_PER_US));
+        IsrCyc += isr;
+        Cyc += isr;
+    }
+}
+
+/**
+ * @brief Timer2 count at the current cycle.
+ */
+static uint16_t Timer2(void)
+{
+    return (uint16_t)(T1MS + (Cyc / 12) % T2_PERIOD);
+}
+
+uint8_t SimTH2(void)
+{
+    Advance();
+    return (uint8_t)(Timer2() >> 8);
+}
+
+uint8_t SimTL2(void)
+{
+    Advance();
+    return (uint8_t)Timer2();
+}
+
+uint8_t SimTF2(void)
+{
+    return 0;
+}
+
+/**
+ * @brief Stand-in for TimeStamp.c: ms ticks, waking from idle at the next tick.
+ */
+uint32_t TimeNowMs(void)
+{
+    if (PCON & 0x01)
+    {
+        Idles++;
+        Cyc = (Cyc / TICK_CYC + 1) * TICK_CYC;
+        PCON &= (uint8_t)~0x01;
+    }
+    Advance();
+    return (uint32_t)(Cyc / TICK_CYC);
+}
+
+/**
+ * @brief Stand-in for WDT.c: records the longest refresh gap.
+ */
+void WDTRefresh(void)
+{
+    if (LastWdt && Cyc - LastWdt > WdtGapMax) WdtGapMax = Cyc - LastWdt;
+    LastWdt = Cyc;
+}
+
+/**
+ * @brief Moves the clock to a random point of a tick.
+ */
+static void RandomPhase(void)
+{
+    Cyc += (uint64_t)rand() % TICK_CYC;
+}
+
+/**
+ * @brief SysDelayUs() over a range of requests and timer phases.
+ */
+static void CheckUs(const char* name)
+{
+    static const uint32_t req[] = {1, 2, 5, 10, 58, 100, 999, 1000, 1001, 12345, 499999, 500000, 500001, 2000000};
+    double lo = 1e9, hi = -1e9;
+    size_t i;
+    int p;
+
+    for (i = 0; i < sizeof(req) / sizeof(req[0]); i++)
+    {
+        for (p = 0; p < (req[i] > 100000 ? 10 : PHASES); p++)
+        {
+            uint64_t start;
+            double err, min, max;
+
+            RandomPhase();
+            IsrCyc = 0;
+            start = Cyc;
+            SysDelayUs(req[i]);
+            err = (double)(Cyc - start) / CYC_PER_US - req[i];
+            min = 0;
+            max = req[i] * SCALE_PPM / 1e6 + 1.0 + (double)IsrCyc / CYC_PER_US;
+            if (err < min || err > max)
+            {
+                printf("FAIL %s SysDelayUs(%u): error %+.3f us, allowed %+.3f..%+.3f\n", name, req[i], err, min, max);
+                Failed = 1;
+            }
+            if (err < lo) lo = err;
+            if (err > hi) hi = err;
+        }
+    }
+    printf("SysDelayUs %-12s error %+.3f .. %+.3f us (1 us .. 2 s)\n", name, lo, hi);
+}
+
+/**
+ * @brief SysDelayMs() or SysDelayMsWdtReset() with interrupts on or off.
+ */
+static void CheckMs(int wdt, int irq)
+{
+    static const uint32_t req[] = {1, 2, 10, 100, 1000};
+    double lo = 1e9, hi = -1e9, tickMs = TICK_CYC / CYC_PER_US / 1000.0;
+    size_t i;
+    int p;
+
+    EA = (uint8_t)irq;
+    Idles = 0;
+    WdtGapMax = 0;
+    for (i = 0; i < sizeof(req) / sizeof(req[0]); i++)
+    {
+        for (p = 0; p < 20; p++)
+        {
+            uint64_t start;
+            double ms, min, max;
+
+            RandomPhase();
+            LastWdt = 0;
+            start = Cyc;
+            if (wdt) SysDelayMsWdtReset(req[i]);
+            else SysDelayMs(req[i]);
+            ms = (double)(Cyc - start) / CYC_PER_US / 1000.0;
+            //Tick mode: at least ms whole ticks, ends on the tick after; polled: ms times SysDelayUs(1000)
+            min = irq ? req[i] * tickMs : req[i];
+            max = irq ? (req[i] + 1) * tickMs + 0.001 : req[i] * (1 + SCALE_PPM / 1e6) + req[i] * 0.001;
+            if (ms < min || ms > max)
+            {
+                printf("FAIL %s(%u) %s: %.4f ms, allowed %.4f..%.4f\n", wdt ? "SysDelayMsWdtReset" : "SysDelayMs",
+                       req[i], irq ? "tick" : "polled", ms, min, max);
+                Failed = 1;
+            }
+            if (ms - req[i] < lo) lo = ms - req[i];
+            if (ms - req[i] > hi) hi = ms - req[i];
+        }
+    }
+    printf("%-18s %-6s error %+.4f .. %+.4f ms", wdt ? "SysDelayMsWdtReset" : "SysDelayMs", irq ? "tick" : "polled", lo, hi);
+    if (wdt)
+    {
+        printf(", WDT gap max %.4f ms", (double)WdtGapMax / CYC_PER_US / 1000.0);
+        if (WdtGapMax > 1.005 * 1000 * CYC_PER_US)
+        {
+            printf("\nFAIL watchdog refreshed less than every 1 ms");
+            Failed = 1;
+        }
+    }
+    else if (irq)
+    {
+        printf(", %u idle entries", Idles);
+#if DELAY_IDLE_ENABLE
+        if (Idles == 0)
+        {
+            printf("\nFAIL SysDelayMs never idled the CPU");
+            Failed = 1;
+        }
+#endif
+    }
+    printf("\n");
+    EA = 1;
+}
+
+int main(void)
+{
+    srand(1);
+    printf("FOSC %lu Hz, Timer2 %lu counts per tick\n", (unsigned long)FOSC, (unsigned long)T2_PERIOD);
+    IsrOn = 0;
+    CheckUs("quiet");
+    IsrOn = 1;
+    CheckUs("with ISRs");
+    IsrOn = 0;
+    CheckMs(0, 1);
+    CheckMs(0, 0);
+    CheckMs(1, 1);
+    CheckMs(1, 0);
+    return Failed;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
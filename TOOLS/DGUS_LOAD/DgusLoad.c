@@ -0,0 +1,718 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file DgusLoad.c
+ * @brief Linux load generator and conformance tester for the DGUS UART protocol.
+ *
+ * Speaks the framing implemented by UartHandleFrame()/Deal82Cmd()/Deal83Cmd()
+ * in C51/HANDWARE/UART/UART.c:
+ *   0x82 write : 5A A5 LEN 82 AH AL D0 D1 ... [CRCL CRCH]
+ *   0x83 read  : 5A A5 LEN 83 AH AL N         [CRCL CRCH]
+ *   0x82 ack   : 5A A5 03 82 4F 4B            (5A A5 05 82 4F 4B A5 EF with CRC)
+ *   0x83 reply : 5A A5 LEN 83 AH AL N D0 ...  [CRCL CRCH]
+ * LEN counts every byte after itself, CRC is CRC-16/Modbus over the bytes
+ * from the command code up to the CRC, low byte first.
+ *
+ * Targets:
+ *   -d /dev/ttyUSB0   a real panel on a serial port;
+ *   -d /dev/pts/N     the PTY printed by TOOLS/UART_HOST, which runs
+ *                     UART.c compiled for the host;
+ *   -m                a built-in protocol model on an internal PTY pair,
+ *                     used to self-check the tool and as a reference.
+ *
+ * Build: cc -O2 -Wall -o DgusLoad DgusLoad.c -lpthread
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define DTHD1                   0x5A    ///< Frame header byte 1 (GlobalConfig.h).
+#define DTHD2                   0xA5    ///< Frame header byte 2 (GlobalConfig.h).
+#define FRAME_MAX               264     ///< UARTX_FRAME_DATA_LENGTH in UART.h.
+#define WORDS_MAX               120     ///< Largest payload that fits LEN and TX buffer.
+#define WINDOW_MAX              64      ///< Maximum number of outstanding requests.
+#define VP_WORDS                0x10000 ///< Size of the model VP space.
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief Run configuration taken from the command line.
+ */
+typedef struct
+{
+    const char* Device;         ///< Serial device or PTY path.
+    uint32_t    Baud;           ///< Serial baud rate.
+    int         Model;          ///< Run against the built-in model.
+    uint32_t    ModelDelayUs;   ///< Model processing time per frame.
+    int         Crc;            ///< Append and check CRC16.
+    int         WriteAck;       ///< Expect 0x82 acknowledges (RESPONSE_UARTx).
+    int         ReadPercent;    ///< Share of 0x83 transactions.
+    uint16_t    AddrStart;      ///< First VP address of the test window.
+    uint16_t    AddrCount;      ///< Size of the test window in words.
+    uint8_t     WordsMin;       ///< Minimum words per transaction.
+    uint8_t     WordsMax;       ///< Maximum words per transaction.
+    uint32_t    Count;          ///< Number of transactions (0 = use Seconds).
+    uint32_t    Seconds;        ///< Test duration when Count is 0.
+    uint32_t    Window;         ///< Maximum outstanding requests.
+    uint32_t    Rate;           ///< Target transactions per second (0 = open).
+    uint32_t    TimeoutMs;      ///< Response timeout per transaction.
+    int         Verify;         ///< Read back every write and compare.
+    uint32_t    Seed;           ///< Random seed.
+} LoadConfig;
+
+/**
+ * @brief One outstanding transaction.
+ */
+typedef struct
+{
+    uint8_t  Code;              ///< 0x82 or 0x83.
+    uint16_t Addr;              ///< VP address.
+    uint8_t  Words;             ///< Word count.
+    uint64_t SentNs;            ///< Send timestamp.
+} LoadPending;
+
+/**
+ * @brief Result counters.
+ */
+typedef struct
+{
+    uint64_t Sent;              ///< Transactions sent.
+    uint64_t Done;              ///< Transactions answered.
+    uint64_t Writes;            ///< 0x82 transactions completed.
+    uint64_t Reads;             ///< 0x83 transactions completed.
+    uint64_t Lost;              ///< Requests that were never answered.
+    uint64_t BadCrc;            ///< Replies with a wrong CRC.
+    uint64_t BadFrame;          ///< Replies that do not match any request.
+    uint64_t Unsolicited;       ///< Auto-upload frames (Read0xF00).
+    uint64_t VerifyErr;         ///< Read-back mismatches.
+    uint64_t TxBytes;           ///< Bytes written to the port.
+    uint64_t RxBytes;           ///< Bytes read from the port.
+    uint64_t* Latency;          ///< Latency samples in ns.
+    uint64_t LatencyCnt;        ///< Number of latency samples.
+    uint64_t LatencyCap;        ///< Capacity of Latency.
+} LoadStats;
+
+/**
+ * @brief Receive-side frame assembler, same states as UartHandleFrame().
+ */
+typedef struct
+{
+    uint8_t  State;             ///< 0 = header 1, 1 = header 2, 2 = length, 3 = body.
+    uint8_t  Buf[FRAME_MAX + 3];///< Frame bytes including header and length.
+    uint16_t Len;               ///< Bytes collected.
+} FrameParser;
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+static LoadConfig Cfg =
+{
+    NULL, 115200, 0, 0, 0, 1, 50, 0x1000, 0x0400, 1, 16, 0, 10, 1, 0, 200, 0, 1
+};
+
+static LoadStats Stats;
+
+static uint16_t Shadow[VP_WORDS];   ///< Last written value of each VP word.
+static uint8_t  ShadowValid[VP_WORDS];
+
+static uint16_t ModelVp[VP_WORDS];  ///< VP memory of the built-in model.
+static int      ModelFd = -1;
+static volatile int ModelRun = 0;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Returns CLOCK_MONOTONIC in nanoseconds.
+ */
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief CRC-16/Modbus, bit-for-bit compatible with Crc16Table().
+ */
+static uint16_t Crc16(const uint8_t* p, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t  i;
+    while (len--)
+    {
+        crc ^= *p++;
+        for (i = 0; i < 8; i++) crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief Appends the CRC to a frame whose LEN byte already includes it.
+ */
+static void FrameSeal(uint8_t* f)
+{
+    uint16_t crc = Crc16(f + 3, (uint16_t)(f[2] - 2));
+    f[f[2] + 1] = (uint8_t)crc;
+    f[f[2] + 2] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief Checks the CRC of a received frame.
+ */
+static int FrameCrcOk(const uint8_t* f)
+{
+    uint16_t crc;
+    if (f[2] < 3) return 0;
+    crc = Crc16(f + 3, (uint16_t)(f[2] - 2));
+    return (f[f[2] + 1] == (uint8_t)crc) && (f[f[2] + 2] == (uint8_t)(crc >> 8));
+}
+
+/**
+ * @brief Writes a whole buffer to a file descriptor.
+ */
+static int WriteAll(int fd, const uint8_t* p, size_t n)
+{
+    while (n)
+    {
+        ssize_t w = write(fd, p, n);
+        if (w < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN) { struct pollfd pf = {fd, POLLOUT, 0}; poll(&pf, 1, 10); continue; }
+            return -1;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+/**
+ * @brief Feeds one byte into the frame assembler.
+ * @return 1 when a complete frame is in p->Buf.
+ */
+static int FrameFeed(FrameParser* p, uint8_t c)
+{
+    switch (p->State)
+    {
+    case 0:
+        if (c == DTHD1) { p->Buf[0] = c; p->State = 1; }
+        break;
+    case 1:
+        if (c == DTHD2) { p->Buf[1] = c; p->State = 2; }
+        else p->State = (c == DTHD1) ? 1 : 0;
+        break;
+    case 2:
+        if (c < 3) { p->State = 0; break; }
+        p->Buf[2] = c;
+        p->Len = 3;
+        p->State = 3;
+        break;
+    default:
+        p->Buf[p->Len++] = c;
+        if (p->Len == (uint16_t)p->Buf[2] + 3)
+        {
+            p->State = 0;
+            return 1;
+        }
+        break;
+    }
+    return 0;
+}
+
+//==============================================================================
+//---------------------------------MODEL----------------------------------------
+//==============================================================================
+/**
+ * @brief Executes one frame against the model VP memory, like DealUartData().
+ */
+static void ModelDeal(const uint8_t* f)
+{
+    uint8_t  out[FRAME_MAX + 8];
+    uint16_t addr = (uint16_t)((f[4] << 8) | f[5]);
+    uint8_t  len = f[2];
+    uint16_t i;
+
+    if (Cfg.Crc)
+    {
+        if (!FrameCrcOk(f)) return;
+        len -= 2;
+    }
+    if (f[3] == 0x82)
+    {
+        uint16_t words = (uint16_t)((len - 3) / 2);
+        for (i = 0; i < words; i++) ModelVp[(uint16_t)(addr + i)] = (uint16_t)((f[6 + 2 * i] << 8) | f[7 + 2 * i]);
+        if (!Cfg.WriteAck) return;
+        out[0] = DTHD1; out[1] = DTHD2; out[2] = 0x03; out[3] = 0x82; out[4] = 0x4F; out[5] = 0x4B;
+        if (Cfg.Crc) { out[2] = 0x05; FrameSeal(out); }
+        WriteAll(ModelFd, out, (size_t)out[2] + 3);
+    }
+    else if (f[3] == 0x83)
+    {
+        uint8_t n = f[6];
+        if (n > WORDS_MAX) return;
+        memcpy(out, f, 7);
+        for (i = 0; i < n; i++)
+        {
+            out[7 + 2 * i] = (uint8_t)(ModelVp[(uint16_t)(addr + i)] >> 8);
+            out[8 + 2 * i] = (uint8_t)ModelVp[(uint16_t)(addr + i)];
+        }
+        out[2] = (uint8_t)(2 * n + 4);
+        if (Cfg.Crc) { out[2] += 2; FrameSeal(out); }
+        WriteAll(ModelFd, out, (size_t)out[2] + 3);
+    }
+}
+
+/**
+ * @brief Model thread: assembles frames from the PTY master and answers them.
+ */
+static void* ModelThread(void* arg)
+{
+    FrameParser p;
+    uint8_t buf[512];
+    (void)arg;
+    memset(&p, 0, sizeof(p));
+    while (ModelRun)
+    {
+        struct pollfd pf = {ModelFd, POLLIN, 0};
+        ssize_t n, i;
+        if (poll(&pf, 1, 50) <= 0) continue;
+        n = read(ModelFd, buf, sizeof(buf));
+        if (n <= 0) continue;
+        for (i = 0; i < n; i++)
+        {
+            if (FrameFeed(&p, buf[i]))
+            {
+                if (Cfg.ModelDelayUs) usleep(Cfg.ModelDelayUs);
+                ModelDeal(p.Buf);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Creates the PTY pair and starts the model.
+ * @return Slave path to open as the device.
+ */
+static const char* ModelStart(pthread_t* th)
+{
+    struct termios tio;
+    ModelFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (ModelFd < 0 || grantpt(ModelFd) || unlockpt(ModelFd)) { perror("posix_openpt"); exit(2); }
+    tcgetattr(ModelFd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(ModelFd, TCSANOW, &tio);
+    ModelRun = 1;
+    pthread_create(th, NULL, ModelThread, NULL);
+    return ptsname(ModelFd);
+}
+
+//==============================================================================
+//---------------------------------PORT-----------------------------------------
+//==============================================================================
+/**
+ * @brief Maps a numeric baud rate to a termios constant.
+ */
+static speed_t BaudToSpeed(uint32_t baud)
+{
+    switch (baud)
+    {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief Opens the port in raw 8N1 mode.
+ */
+static int PortOpen(const char* path, uint32_t baud)
+{
+    struct termios tio;
+    speed_t sp = BaudToSpeed(baud);
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) { perror(path); exit(2); }
+    if (sp == 0) { fprintf(stderr, "unsupported baud rate %u\n", baud); exit(2); }
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+        cfsetispeed(&tio, sp);
+        cfsetospeed(&tio, sp);
+        tcsetattr(fd, TCSANOW, &tio);
+        tcflush(fd, TCIOFLUSH);
+    }
+    return fd;
+}
+
+//==============================================================================
+//-------------------------------GENERATOR--------------------------------------
+//==============================================================================
+/**
+ * @brief Builds one request frame and records it as pending.
+ * @return Frame length in bytes.
+ */
+static size_t BuildRequest(uint8_t* f, LoadPending* pend, int forceRead, uint16_t addr, uint8_t words)
+{
+    uint8_t i;
+    int read = forceRead || ((int)(rand() % 100) < Cfg.ReadPercent);
+    f[0] = DTHD1;
+    f[1] = DTHD2;
+    f[4] = (uint8_t)(addr >> 8);
+    f[5] = (uint8_t)addr;
+    if (read)
+    {
+        f[2] = 0x04;
+        f[3] = 0x83;
+        f[6] = words;
+    }
+    else
+    {
+        f[2] = (uint8_t)(3 + 2 * words);
+        f[3] = 0x82;
+        for (i = 0; i < words; i++)
+        {
+            uint16_t v = (uint16_t)rand();
+            uint16_t a = (uint16_t)(addr + i);
+            f[6 + 2 * i] = (uint8_t)(v >> 8);
+            f[7 + 2 * i] = (uint8_t)v;
+            Shadow[a] = v;
+            ShadowValid[a] = 1;
+        }
+    }
+    if (Cfg.Crc) { f[2] += 2; FrameSeal(f); }
+    pend->Code = f[3];
+    pend->Addr = addr;
+    pend->Words = words;
+    return (size_t)f[2] + 3;
+}
+
+/**
+ * @brief Stores a latency sample.
+ */
+static void StatsLatency(uint64_t ns)
+{
+    if (Stats.LatencyCnt == Stats.LatencyCap)
+    {
+        Stats.LatencyCap = Stats.LatencyCap ? Stats.LatencyCap * 2 : 65536;
+        Stats.Latency = realloc(Stats.Latency, Stats.LatencyCap * sizeof(uint64_t));
+        if (!Stats.Latency) { perror("realloc"); exit(2); }
+    }
+    Stats.Latency[Stats.LatencyCnt++] = ns;
+}
+
+/**
+ * @brief qsort comparator for latency samples.
+ */
+static int CmpU64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Matches a reply against the pending queue.
+ * @param q Pending queue (ring).
+ * @param head Index of the oldest entry.
+ * @param cnt Number of entries.
+ * @return 1 if the reply completed a request.
+ */
+static int MatchReply(const uint8_t* f, LoadPending* q, uint32_t* head, uint32_t* cnt, uint64_t now)
+{
+    uint32_t k;
+    uint8_t  len = f[2];
+
+    if (Cfg.Crc)
+    {
+        if (!FrameCrcOk(f)) { Stats.BadCrc++; return 0; }
+        len -= 2;
+    }
+    for (k = 0; k < *cnt; k++)
+    {
+        LoadPending* p = &q[(*head + k) % WINDOW_MAX];
+        int hit = 0;
+        if (f[3] == 0x82 && p->Code == 0x82 && len == 3 && f[4] == 0x4F && f[5] == 0x4B) hit = 1;
+        if (f[3] == 0x83 && p->Code == 0x83 && f[6] == p->Words && ((f[4] << 8) | f[5]) == p->Addr && len == 4 + 2 * p->Words) hit = 1;
+        if (!hit) continue;
+
+        // Everything older than the matched request was dropped by the target.
+        Stats.Lost += k;
+        if (p->Code == 0x83)
+        {
+            uint8_t i;
+            Stats.Reads++;
+            if (Cfg.Verify)
+            {
+                for (i = 0; i < p->Words; i++)
+                {
+                    uint16_t a = (uint16_t)(p->Addr + i);
+                    uint16_t v = (uint16_t)((f[7 + 2 * i] << 8) | f[8 + 2 * i]);
+                    if (ShadowValid[a] && Shadow[a] != v) Stats.VerifyErr++;
+                }
+            }
+        }
+        else
+        {
+            Stats.Writes++;
+        }
+        StatsLatency(now - p->SentNs);
+        Stats.Done++;
+        *head = (*head + k + 1) % WINDOW_MAX;
+        *cnt -= k + 1;
+        return 1;
+    }
+    if (f[3] == 0x83) Stats.Unsolicited++;
+    else Stats.BadFrame++;
+    return 0;
+}
+
+/**
+ * @brief Runs the load test.
+ */
+static void RunLoad(int fd)
+{
+    LoadPending q[WINDOW_MAX];
+    uint32_t head = 0, cnt = 0;
+    uint8_t  f[FRAME_MAX + 8];
+    uint8_t  rx[1024];
+    FrameParser parser;
+    uint64_t start = NowNs();
+    uint64_t end = start + (uint64_t)Cfg.Seconds * 1000000000ULL;
+    uint64_t nextSend = start;
+    uint64_t period = Cfg.Rate ? 1000000000ULL / Cfg.Rate : 0;
+    int verifyNext = 0;
+    uint16_t verifyAddr = 0;
+    uint8_t verifyWords = 0;
+    double secs;
+    uint64_t p50, p90, p99, p999, pmax;
+
+    memset(&parser, 0, sizeof(parser));
+    for (;;)
+    {
+        uint64_t now = NowNs();
+        int more = Cfg.Count ? (Stats.Sent < Cfg.Count || verifyNext) : (now < end);
+        struct pollfd pf = {fd, POLLIN, 0};
+        ssize_t n, i;
+
+        if (!more && cnt == 0) break;
+
+        // Expire requests that exceeded the timeout.
+        while (cnt && now - q[head].SentNs > (uint64_t)Cfg.TimeoutMs * 1000000ULL)
+        {
+            Stats.Lost++;
+            head = (head + 1) % WINDOW_MAX;
+            cnt--;
+        }
+
+        // Send when the window and the rate limit allow it.
+        if (more && cnt < Cfg.Window && now >= nextSend)
+        {
+            LoadPending* p = &q[(head + cnt) % WINDOW_MAX];
+            uint8_t words = (uint8_t)(Cfg.WordsMin + (Cfg.WordsMax > Cfg.WordsMin ? rand() % (Cfg.WordsMax - Cfg.WordsMin + 1) : 0));
+            uint16_t addr = (uint16_t)(Cfg.AddrStart + rand() % (Cfg.AddrCount > words ? Cfg.AddrCount - words + 1 : 1));
+            size_t len;
+            if (verifyNext) { addr = verifyAddr; words = verifyWords; }
+            len = BuildRequest(f, p, verifyNext, addr, words);
+            verifyNext = 0;
+            if (Cfg.Verify && p->Code == 0x82) { verifyNext = 1; verifyAddr = addr; verifyWords = words; }
+            p->SentNs = NowNs();
+            if (WriteAll(fd, f, len)) { perror("write"); exit(2); }
+            Stats.TxBytes += len;
+            Stats.Sent++;
+            if (p->Code == 0x82 && !Cfg.WriteAck)
+            {
+                Stats.Writes++;
+                Stats.Done++;
+            }
+            else
+            {
+                cnt++;
+            }
+            nextSend = period ? nextSend + period : 0;
+            if (period && nextSend < now) nextSend = now;
+            continue;
+        }
+
+        if (poll(&pf, 1, 1) <= 0) continue;
+        n = read(fd, rx, sizeof(rx));
+        if (n <= 0) continue;
+        Stats.RxBytes += (uint64_t)n;
+        now = NowNs();
+        for (i = 0; i < n; i++)
+        {
+            if (FrameFeed(&parser, rx[i])) MatchReply(parser.Buf, q, &head, &cnt, now);
+        }
+    }
+
+    secs = (double)(NowNs() - start) / 1e9;
+    qsort(Stats.Latency, Stats.LatencyCnt, sizeof(uint64_t), CmpU64);
+    p50 = p90 = p99 = p999 = pmax = 0;
+    if (Stats.LatencyCnt)
+    {
+        p50 = Stats.Latency[Stats.LatencyCnt * 50 / 100];
+        p90 = Stats.Latency[Stats.LatencyCnt * 90 / 100];
+        p99 = Stats.Latency[Stats.LatencyCnt * 99 / 100];
+        p999 = Stats.Latency[Stats.LatencyCnt * 999 / 1000];
+        pmax = Stats.Latency[Stats.LatencyCnt - 1];
+    }
+    printf("duration      %.3f s\n", secs);
+    printf("transactions  %llu sent, %llu done (%llu write, %llu read)\n",
+           (unsigned long long)Stats.Sent, (unsigned long long)Stats.Done,
+           (unsigned long long)Stats.Writes, (unsigned long long)Stats.Reads);
+    printf("throughput    %.1f tx/s, %.1f kB/s out, %.1f kB/s in\n",
+           Stats.Done / secs, Stats.TxBytes / secs / 1024.0, Stats.RxBytes / secs / 1024.0);
+    printf("latency us    p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+           p50 / 1e3, p90 / 1e3, p99 / 1e3, p999 / 1e3, pmax / 1e3);
+    printf("errors        lost %llu, bad crc %llu, bad frame %llu, verify %llu, unsolicited %llu\n",
+           (unsigned long long)Stats.Lost, (unsigned long long)Stats.BadCrc,
+           (unsigned long long)Stats.BadFrame, (unsigned long long)Stats.VerifyErr,
+           (unsigned long long)Stats.Unsolicited);
+}
+
+//==============================================================================
+//-----------------------------------MAIN---------------------------------------
+//==============================================================================
+/**
+ * @brief Prints command line help.
+ */
+static void Usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s (-d DEVICE | -m) [options]\n"
+        "  -d DEVICE    serial port or the PTY of TOOLS/UART_HOST\n"
+        "  -m           use the built-in protocol model on an internal PTY\n"
+        "  -D US        model processing time per frame (with -m)\n"
+        "  -b BAUD      baud rate (default 115200)\n"
+        "  -c           CRC16 framing (CRC_CHECK_UARTx = 1)\n"
+        "  -A           writes are not acknowledged (RESPONSE_UARTx = 0)\n"
+        "  -r PCT       percentage of 0x83 reads (default 50)\n"
+        "  -a ADDR:CNT  VP test window (default 0x1000:0x400)\n"
+        "  -w MIN:MAX   words per transaction (default 1:16, max %d)\n"
+        "  -n COUNT     number of transactions\n"
+        "  -t SECONDS   test duration when -n is not given (default 10)\n"
+        "  -W WINDOW    outstanding requests (default 1, max %d)\n"
+        "  -R RATE      target transactions per second (default unlimited)\n"
+        "  -T MS        response timeout (default 200)\n"
+        "  -v           read back every write and compare\n"
+        "  -s SEED      random seed\n",
+        name, WORDS_MAX, WINDOW_MAX);
+    exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    pthread_t th;
+    int opt, fd;
+    unsigned a, b;
+
+    while ((opt = getopt(argc, argv, "d:mD:b:cAr:a:w:n:t:W:R:T:vs:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd': Cfg.Device = optarg; break;
+        case 'm': Cfg.Model = 1; break;
+        case 'D': Cfg.ModelDelayUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'b': Cfg.Baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'c': Cfg.Crc = 1; break;
+        case 'A': Cfg.WriteAck = 0; break;
+        case 'r': Cfg.ReadPercent = atoi(optarg); break;
+        case 'a':
+            if (sscanf(optarg, "%i:%i", (int*)&a, (int*)&b) != 2) Usage(argv[0]);
+            Cfg.AddrStart = (uint16_t)a; Cfg.AddrCount = (uint16_t)b;
+            break;
+        case 'w':
+            if (sscanf(optarg, "%u:%u", &a, &b) != 2) Usage(argv[0]);
+            Cfg.WordsMin = (uint8_t)a; Cfg.WordsMax = (uint8_t)b;
+            break;
+        case 'n': Cfg.Count = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 't': Cfg.Seconds = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'W': Cfg.Window = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'R': Cfg.Rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'T': Cfg.TimeoutMs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'v': Cfg.Verify = 1; break;
+        case 's': Cfg.Seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        default: Usage(argv[0]);
+        }
+    }
+    if ((Cfg.Device == NULL) == (Cfg.Model == 0)) Usage(argv[0]);
+    if (Cfg.WordsMin == 0 || Cfg.WordsMax < Cfg.WordsMin || Cfg.WordsMax > WORDS_MAX) Usage(argv[0]);
+    if (Cfg.Window == 0 || Cfg.Window > WINDOW_MAX) Usage(argv[0]);
+    if (Cfg.AddrCount < Cfg.WordsMax) Usage(argv[0]);
+    // Read-back needs the reply of the write before the read goes out.
+    if (Cfg.Verify) Cfg.Window = 1;
+    srand(Cfg.Seed);
+
+    if (Cfg.Model) Cfg.Device = ModelStart(&th);
+    fd = PortOpen(Cfg.Device, Cfg.Baud);
+    RunLoad(fd);
+    close(fd);
+    if (Cfg.Model)
+    {
+        ModelRun = 0;
+        pthread_join(th, NULL);
+        close(ModelFd);
+    }
+    return (Stats.Lost || Stats.BadCrc || Stats.VerifyErr) ? 3 : 0;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
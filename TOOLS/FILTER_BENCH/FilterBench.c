@@ -0,0 +1,252 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file FilterBench.c
+ * @brief Host checks and benchmark of the firmware filter library.
+ *
+ * Compiles C51/HANDWARE/FILTER/FILTER.c unchanged for the host, runs step
+ * and impulse responses of every filter type against their closed-form
+ * expectations and prints the cost of one FilterUpdate() per type in host
+ * cycles. The numbers rank the variants; they are not 8051 figures.
+ * Exits non-zero if any check fails.
+ *
+ * Build (from this directory):
+ *   cc -O2 -I../HOST -I../../C51/HANDWARE/SYSTEM -I../../C51/HANDWARE/FILTER
+ *      -o FilterBench FilterBench.c ../../C51/HANDWARE/FILTER/FILTER.c
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "SYSTEM.h"
+#include "FILTER.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define BENCH_LEN       4096    ///< Samples per timed block.
+#define BENCH_ROUNDS    2000    ///< Timed blocks per variant.
+#define STEP            1000    ///< Step and impulse height.
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+static uint16_t Data[BENCH_LEN];
+static int Failed = 0;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief Returns a cycle counter (TSC) or nanoseconds where there is none.
+ */
+static uint64_t Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Compares a result with the expected value.
+ */
+static void Expect(const char* what, int n, uint32_t got, uint32_t want)
+{
+    if (got != want)
+    {
+        printf("FAIL %-28s n=%-4d got %u want %u\n", what, n, got, want);
+        Failed = 1;
+    }
+}
+
+/**
+ * @brief IIR: the step follows the exact integer recurrence and settles on the
+ *        input; the impulse peaks at STEP / 2^k and decays back to 0.
+ */
+static void CheckIir(uint8_t k)
+{
+    Filter f;
+    uint32_t s = 0;
+    uint16_t y = 0, prev = 0;
+    int n;
+
+    FilterInit(&f, FILTER_IIR, k);
+    Expect("iir prime", 0, FilterUpdate(&f, 0), 0);
+    for (n = 1; n < (40 << k); n++)
+    {
+        s = s - (s >> k) + STEP;
+        y = FilterUpdate(&f, STEP);
+        Expect("iir step recurrence", n, y, s >> k);
+        if (y < prev) Expect("iir step monotonic", n, y, prev);
+        prev = y;
+    }
+    Expect("iir step settles", n, y, STEP);
+    Expect("iir step back", n, FilterUpdate(&f, STEP), STEP);
+
+    FilterInit(&f, FILTER_IIR, k);
+    FilterUpdate(&f, 0);
+    Expect("iir impulse peak", 1, FilterUpdate(&f, STEP), STEP >> k);
+    for (n = 2; n < (40 << k); n++) y = FilterUpdate(&f, 0);
+    Expect("iir impulse decays", n, y, 0);
+}
+
+/**
+ * @brief Moving average: the step is a linear ramp of 2^b samples and the
+ *        impulse a box of height STEP / 2^b and width 2^b.
+ */
+static void CheckAverage(uint8_t b)
+{
+    Filter f;
+    int len = 1 << b;
+    int n;
+
+    FilterInit(&f, FILTER_AVERAGE, b);
+    FilterUpdate(&f, 0);
+    for (n = 1; n <= 2 * len; n++)
+    {
+        Expect("avg step ramp", n, FilterUpdate(&f, STEP), (uint32_t)STEP * (n < len ? n : len) >> b);
+    }
+
+    FilterInit(&f, FILTER_AVERAGE, b);
+    FilterUpdate(&f, 0);
+    for (n = 1; n <= 2 * len; n++)
+    {
+        Expect("avg impulse box", n, FilterUpdate(&f, n == 1 ? STEP : 0), n <= len ? STEP >> b : 0);
+    }
+}
+
+/**
+ * @brief Median: the step is delayed by half the window, a single-sample
+ *        impulse never reaches the output, and the window matches a sort.
+ */
+static void CheckMedian(uint8_t w)
+{
+    Filter f;
+    uint16_t win[FILTER_MEDIAN_MAX], t;
+    int n, i, j;
+
+    FilterInit(&f, FILTER_MEDIAN, w);
+    FilterUpdate(&f, 0);
+    for (n = 1; n <= w; n++)
+    {
+        Expect("median step delay", n, FilterUpdate(&f, STEP), n > w / 2 ? STEP : 0);
+    }
+
+    FilterInit(&f, FILTER_MEDIAN, w);
+    FilterUpdate(&f, 0);
+    for (n = 1; n <= w; n++)
+    {
+        Expect("median impulse rejected", n, FilterUpdate(&f, n == 1 ? STEP : 0), w > 1 ? 0 : (n == 1 ? STEP : 0));
+    }
+
+    FilterInit(&f, FILTER_MEDIAN, w);
+    for (n = 0; n < BENCH_LEN; n++)
+    {
+        uint16_t y = FilterUpdate(&f, Data[n]);
+        for (i = 0; i < w; i++) win[i] = Data[n - i < 0 ? 0 : n - i];
+        for (i = 1; i < w; i++)
+        {
+            for (j = i; j > 0 && win[j - 1] > win[j]; j--) { t = win[j]; win[j] = win[j - 1]; win[j - 1] = t; }
+        }
+        Expect("median vs sort", n, y, win[w / 2]);
+    }
+}
+
+/**
+ * @brief Times one variant and prints its row.
+ */
+static void Bench(FilterType type, uint8_t param, const char* name)
+{
+    uint64_t best = ~0ULL, t;
+    uint32_t sink = 0;
+    Filter f;
+    int r, i;
+
+    FilterInit(&f, type, param);
+    for (r = 0; r < BENCH_ROUNDS; r++)
+    {
+        t = Cycles();
+        for (i = 0; i < BENCH_LEN; i++) sink += FilterUpdate(&f, Data[i]);
+        t = Cycles() - t;
+        if (t < best) best = t;
+    }
+    printf("%-22s %10.2f   (0x%08X)\n", name, (double)best / BENCH_LEN, sink);
+}
+
+int main(void)
+{
+    uint8_t p;
+    char name[32];
+    int i;
+
+    srand(1);
+    for (i = 0; i < BENCH_LEN; i++) Data[i] = (uint16_t)(rand() & 0x0FFF);
+
+    for (p = 1; p <= 8; p++) CheckIir(p);
+    for (p = 0; p <= FILTER_MA_BITS_MAX; p++) CheckAverage(p);
+    for (p = 1; p <= FILTER_MEDIAN_MAX; p += 2) CheckMedian(p);
+
+    printf("FILTER_MA_BITS_MAX %d, FILTER_MEDIAN_MAX %d, %d-sample blocks, best of %d\n",
+           FILTER_MA_BITS_MAX, FILTER_MEDIAN_MAX, BENCH_LEN, BENCH_ROUNDS);
+    printf("%-22s %10s\n", "variant", "cyc/sample");
+    Bench(FILTER_NONE, 0, "none");
+    for (p = 2; p <= 8; p += 3)
+    {
+        snprintf(name, sizeof(name), "iir k=%u", p);
+        Bench(FILTER_IIR, p, name);
+    }
+    for (p = 2; p <= FILTER_MA_BITS_MAX; p += 2)
+    {
+        snprintf(name, sizeof(name), "average %u", 1 << p);
+        Bench(FILTER_AVERAGE, p, name);
+    }
+    for (p = 3; p <= FILTER_MEDIAN_MAX; p += 2)
+    {
+        snprintf(name, sizeof(name), "median %u", p);
+        Bench(FILTER_MEDIAN, p, name);
+    }
+    return Failed;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,126 @@
+#ifndef __GPIO_H__
+#define __GPIO_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file GPIO.h
+ * @brief Host stand-in for C51/HANDWARE/GPIO/GPIO.h.
+ *
+ * Keeps the pin numbering and the constant-pin macros of the firmware
+ * header, but routes every pin access through GpioSimWrite() and
+ * GpioSimRead(), so bit-banged drivers (SPI.c, I2C.c) run against a pin
+ * model. Whole-port access follows the 8051: P0..P3 read the pin levels
+ * (GpioSimPort()) and cannot be assigned, and GPIO_LATCH_CLR/SET change the
+ * latches (GpioSimLatch()), so the firmware GPIO.c links unchanged and a
+ * port write built from a pin read does not compile. The pin model is
+ * provided by the tool that links the module, which also defines EA and
+ * PxMDOUT.
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include "SYSTEM.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define GPIO_PORT_0				0
+#define GPIO_PORT_1				1
+#define GPIO_PORT_2				2
+#define GPIO_PORT_3				3
+
+#define GPIO_PIN_0				0
+#define GPIO_PIN_1				1
+#define GPIO_PIN_2				2
+#define GPIO_PIN_3				3
+#define GPIO_PIN_4				4
+#define GPIO_PIN_5				5
+#define GPIO_PIN_6				6
+#define GPIO_PIN_7				7
+
+#define GPIO_SET(Pin)			GpioSimWrite(Pin, 1)
+#define GPIO_CLR(Pin)			GpioSimWrite(Pin, 0)
+#define GPIO_WRITE(Pin, Level)	GpioSimWrite(Pin, (Level) ? 1 : 0)
+#define GPIO_READ(Pin)			GpioSimRead(Pin)
+#define GPIO_TOGGLE(Pin)		GpioSimWrite(Pin, !GpioSimRead(Pin))
+
+#define GPIO_LATCH_CLR(Port, Bits)	GpioSimLatch(Port, Bits, 0)
+#define GPIO_LATCH_SET(Port, Bits)	GpioSimLatch(Port, Bits, 1)
+
+#define P0						GpioSimPort(GPIO_PORT_0)
+#define P1						GpioSimPort(GPIO_PORT_1)
+#define P2						GpioSimPort(GPIO_PORT_2)
+#define P3						GpioSimPort(GPIO_PORT_3)
+
+typedef enum
+{
+    GPIO_OK = 0x00,
+    GPIO_ERR = 0xFF,
+} EGpioStatus;
+
+typedef enum
+{
+    GPIO_LOW = 0,
+    GPIO_HIGHT = 1,
+} EPinState;
+
+typedef enum
+{
+    GPIO_IN = 0,
+    GPIO_OUT = 1,
+} EPinType;
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+extern uint8_t EA;
+extern uint8_t P0MDOUT, P1MDOUT, P2MDOUT, P3MDOUT;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+void GpioSimWrite(uint8_t Port, uint8_t Pin, uint8_t Level);
+uint8_t GpioSimRead(uint8_t Port, uint8_t Pin);
+uint8_t GpioSimPort(uint8_t Port);
+void GpioSimLatch(uint8_t Port, uint8_t Bits, uint8_t Level);
+uint8_t GpioPortRead(uint8_t Port);
+EGpioStatus GpioPortMask(uint8_t Port, uint8_t Mask, uint8_t Value);
+EGpioStatus GpioPortWrite(uint8_t Port, uint8_t Value);
+EGpioStatus InitGpio(EPinType Type, uint8_t Port, uint8_t Pin, EPinState StatePin);
+EGpioStatus GetGpioState(uint8_t Port, uint8_t Pin, EPinState* StatePin);
+EGpioStatus SetGpioOutState(uint8_t Port, uint8_t Pin, EPinState State);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
@@ -0,0 +1,83 @@
+#ifndef __SYSTEM_H__
+#define __SYSTEM_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file SYSTEM.h
+ * @brief Host stand-in for C51/HANDWARE/SYSTEM/SYSTEM.h.
+ *
+ * Lets portable firmware modules (CRC16.c, CHECKSUM.c, ...) be compiled
+ * with a host compiler: Keil memory-space keywords are removed, the
+ * fixed-width types come from <stdint.h> and the DGUS accessors are
+ * provided by the tool that links the module.
+ * Put this directory on the include path before the firmware directories.
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#include <stdint.h>
+#include "GlobalConfig.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define code
+#define data
+#define xdata
+#define idata
+#define pdata
+#define bit                 uint8_t
+
+#define FOSC                206438400UL
+#define T1MS                (65536-FOSC/12/1000)
+
+typedef enum
+{
+    NOR_OK = 0x00,
+    NOR_TIMEOUT = 0xFF,
+} NorStatus;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+uint16_t ReadDgus(uint16_t Dgus_Addr);
+void WriteDgus(uint16_t Dgus_Addr, uint16_t Val);
+void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16);
+void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16);
+NorStatus NorFlashRead(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16);
+NorStatus NorFlashWrite(uint32_t NorAddr, uint16_t VpAddr, uint16_t Len16);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif
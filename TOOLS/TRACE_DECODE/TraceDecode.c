@@ -0,0 +1,616 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file TraceDecode.c
+ * @brief Fetches and decodes the firmware event trace (C51/HANDWARE/TRACE).
+ *
+ * Request : 5A A5 04 8F 00 FLAGS 00       [CRCL CRCH]   FLAGS bit 0 = clear
+ * Reply   : 5A A5 LEN 8F LAST SEQH SEQL N  E0 ... E(N-1) [CRCL CRCH]
+ * Entry   : EVENT ARGH ARGL T3 T2 T1 T0    (T = Timer2 ticks, FOSC/12)
+ *
+ * Prints a timeline, then per-event log2 histograms: the duration of paired
+ * events (begin code even, end code = begin + 1, e.g. ISR enter/exit, task
+ * run, DGUS access) keyed by code and argument, and the interval between
+ * consecutive instant events keyed by code.
+ *
+ *   -d /dev/ttyUSB0   request a dump from a panel (optionally saved with -o);
+ *   -i FILE           decode a dump saved earlier with -o;
+ *   -t                self-test: run both request forms through a copy of
+ *                     the firmware receive parser (UartHandleFrame).
+ *
+ * Build: cc -O2 -Wall -o TraceDecode TraceDecode.c
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define DTHD1                   0x5A    ///< Frame header byte 1 (GlobalConfig.h).
+#define DTHD2                   0xA5    ///< Frame header byte 2 (GlobalConfig.h).
+#define TRACE_CMD               0x8F    ///< TRACE_CMD in TRACE.h.
+#define TRACE_REQ_LEN           4       ///< TRACE_REQ_LEN in TRACE.h.
+#define UART_FRAME_MAX          250     ///< UARTX_FRAME_DATA_LENGTH in GlobalConfig.h.
+#define TRACE_ENTRY_SIZE        7       ///< TRACE_ENTRY_SIZE in TRACE.h.
+#define TRACE_EV_INSTANT        0x10    ///< First unpaired event code.
+#define ENTRIES_MAX             4096    ///< More than any TRACE_DEPTH.
+#define HIST_BUCKETS            24      ///< log2 buckets, 1 us to ~8 s.
+#define KEYS_MAX                256     ///< Distinct histogram keys.
+#define OPEN_MAX                16      ///< Nesting depth of paired events.
+
+//==============================================================================
+//--------------------------------Structures------------------------------------
+//==============================================================================
+/**
+ * @brief One decoded trace entry.
+ */
+typedef struct
+{
+    uint16_t Seq;               ///< Firmware sequence number.
+    uint8_t  Event;             ///< Event ID.
+    uint16_t Arg;               ///< Event argument.
+    uint32_t Ticks;             ///< Raw Timer2 ticks.
+    uint64_t Abs;               ///< Ticks unwrapped from the first entry.
+} TraceRec;
+
+/**
+ * @brief Histogram of one event key.
+ */
+typedef struct
+{
+    uint8_t  Event;             ///< Event ID (begin code for pairs).
+    uint16_t Arg;               ///< Argument for pairs, 0 for instants.
+    int      Paired;            ///< Durations (1) or intervals (0).
+    uint64_t Count;             ///< Samples.
+    double   MinUs;             ///< Smallest sample.
+    double   MaxUs;             ///< Largest sample.
+    double   SumUs;             ///< Sum of samples.
+    uint64_t Bucket[HIST_BUCKETS]; ///< Bucket n holds [2^(n-1), 2^n) us.
+    int      HaveLast;          ///< Last is valid (instants).
+    uint64_t Last;              ///< Last occurrence (instants).
+} TraceHist;
+
+/**
+ * @brief Frame assembler state.
+ */
+typedef struct
+{
+    int      State;             ///< 0..2 header/length, 3 body.
+    uint16_t Len;               ///< Bytes in Buf.
+    uint8_t  Buf[260];          ///< Frame being assembled.
+} FrameParser;
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+static TraceRec  Recs[ENTRIES_MAX];
+static size_t    RecCnt;
+static TraceHist Hist[KEYS_MAX];
+static size_t    HistCnt;
+static double    TicksPerUs = 206438400.0 / 12 / 1e6; ///< FOSC/12 of SYSTEM.h.
+static int       Crc;
+static int       Last;
+static uint64_t  BadFrames;
+
+//==============================================================================
+//--------------------------------Functions-------------------------------------
+//==============================================================================
+/**
+ * @brief CRC-16/Modbus, bit-for-bit compatible with Crc16Table().
+ */
+static uint16_t Crc16(const uint8_t* p, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t  i;
+    while (len--)
+    {
+        crc ^= *p++;
+        for (i = 0; i < 8; i++) crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief Feeds one byte into the frame assembler.
+ * @return 1 when a complete frame is in p->Buf.
+ */
+static int FrameFeed(FrameParser* p, uint8_t c)
+{
+    switch (p->State)
+    {
+    case 0:
+        if (c == DTHD1) { p->Buf[0] = c; p->State = 1; }
+        break;
+    case 1:
+        if (c == DTHD2) { p->Buf[1] = c; p->State = 2; }
+        else p->State = (c == DTHD1) ? 1 : 0;
+        break;
+    case 2:
+        if (c < 3) { p->State = 0; break; }
+        p->Buf[2] = c;
+        p->Len = 3;
+        p->State = 3;
+        break;
+    default:
+        p->Buf[p->Len++] = c;
+        if (p->Len == (uint16_t)p->Buf[2] + 3)
+        {
+            p->State = 0;
+            return 1;
+        }
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Takes the entries out of one dump frame.
+ */
+static void FrameDecode(const uint8_t* f)
+{
+    uint16_t body = f[2], seq, i;
+    const uint8_t* e;
+    uint8_t n;
+
+    if (Crc)
+    {
+        uint16_t crc;
+        if (body < 7) { BadFrames++; return; }
+        crc = Crc16(f + 3, (uint16_t)(body - 2));
+        if (f[body + 1] != (uint8_t)crc || f[body + 2] != (uint8_t)(crc >> 8)) { BadFrames++; return; }
+        body -= 2;
+    }
+    if (f[3] != TRACE_CMD || body < 5) { BadFrames++; return; }
+    n = f[7];
+    if (body != 5 + n * TRACE_ENTRY_SIZE) { BadFrames++; return; }
+    seq = (uint16_t)((f[5] << 8) | f[6]);
+    for (i = 0, e = f + 8; i < n && RecCnt < ENTRIES_MAX; i++, e += TRACE_ENTRY_SIZE)
+    {
+        TraceRec* r = &Recs[RecCnt++];
+        r->Seq = (uint16_t)(seq + i);
+        r->Event = e[0];
+        r->Arg = (uint16_t)((e[1] << 8) | e[2]);
+        r->Ticks = ((uint32_t)e[3] << 24) | ((uint32_t)e[4] << 16) | ((uint32_t)e[5] << 8) | e[6];
+    }
+    if (f[4]) Last = 1;
+}
+
+/**
+ * @brief Maps a numeric baud rate to a termios constant.
+ */
+static speed_t BaudToSpeed(uint32_t baud)
+{
+    switch (baud)
+    {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief Opens the port in raw 8N1 mode.
+ */
+static int PortOpen(const char* path, uint32_t baud)
+{
+    struct termios tio;
+    speed_t sp = BaudToSpeed(baud);
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) { perror(path); exit(2); }
+    if (sp == 0) { fprintf(stderr, "unsupported baud rate %u\n", baud); exit(2); }
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+        cfsetispeed(&tio, sp);
+        cfsetospeed(&tio, sp);
+        tcsetattr(fd, TCSANOW, &tio);
+        tcflush(fd, TCIOFLUSH);
+    }
+    return fd;
+}
+
+/**
+ * @brief Builds the dump request.
+ * @return size_t Bytes in req.
+ */
+static size_t RequestBuild(uint8_t* req, int crc, int clear)
+{
+    req[0] = DTHD1;
+    req[1] = DTHD2;
+    req[2] = TRACE_REQ_LEN;
+    req[3] = TRACE_CMD;
+    req[4] = 0;
+    req[5] = (uint8_t)(clear ? 1 : 0);
+    req[6] = 0;
+    if (crc)
+    {
+        uint16_t c = Crc16(req + 3, TRACE_REQ_LEN);
+        req[2] = TRACE_REQ_LEN + 2;
+        req[7] = (uint8_t)c;
+        req[8] = (uint8_t)(c >> 8);
+    }
+    return (size_t)req[2] + 3;
+}
+
+/**
+ * @brief Sends the dump request and collects the reply frames.
+ * @param save Stream receiving the raw reply, or NULL.
+ */
+static void Fetch(const char* dev, uint32_t baud, int clear, int timeoutMs, FILE* save)
+{
+    uint8_t req[9];
+    size_t len = RequestBuild(req, Crc, clear);
+    uint8_t buf[256];
+    FrameParser p = {0};
+    struct pollfd pf;
+    int fd = PortOpen(dev, baud);
+    ssize_t n, i;
+
+    if (write(fd, req, len) != (ssize_t)len) { perror("write"); exit(2); }
+    pf.fd = fd;
+    pf.events = POLLIN;
+    while (!Last)
+    {
+        if (poll(&pf, 1, timeoutMs) <= 0) { fprintf(stderr, "timeout waiting for the dump\n"); break; }
+        n = read(fd, buf, sizeof(buf));
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        if (n <= 0) break;
+        if (save) fwrite(buf, 1, (size_t)n, save);
+        for (i = 0; i < n && !Last; i++)
+            if (FrameFeed(&p, buf[i])) FrameDecode(p.Buf);
+    }
+    close(fd);
+}
+
+/**
+ * @brief Decodes a raw dump saved with -o.
+ */
+static void Load(const char* path)
+{
+    FrameParser p = {0};
+    FILE* f = fopen(path, "rb");
+    int c;
+
+    if (!f) { perror(path); exit(2); }
+    while ((c = fgetc(f)) != EOF && !Last)
+        if (FrameFeed(&p, (uint8_t)c)) FrameDecode(p.Buf);
+    fclose(f);
+}
+
+/**
+ * @brief Returns a printable event name.
+ */
+static const char* EventName(uint8_t ev)
+{
+    switch (ev)
+    {
+    case 0x02: return "ISR_ENTER";
+    case 0x03: return "ISR_EXIT";
+    case 0x04: return "TASK_BEGIN";
+    case 0x05: return "TASK_END";
+    case 0x06: return "DGUS_READ";
+    case 0x07: return "DGUS_READ_END";
+    case 0x08: return "DGUS_WRITE";
+    case 0x09: return "DGUS_WRITE_END";
+    case 0x10: return "FRAME_OK";
+    case 0x11: return "FRAME_BAD";
+    case 0x12: return "FRAME_DROP";
+    case 0x13: return "PAGE";
+    case 0x14: return "INIT";
+    default:   return ev >= 0x80 ? "USER" : "?";
+    }
+}
+
+/**
+ * @brief Finds or creates the histogram of a key.
+ */
+static TraceHist* HistGet(uint8_t ev, uint16_t arg, int paired)
+{
+    size_t i;
+    for (i = 0; i < HistCnt; i++)
+        if (Hist[i].Event == ev && Hist[i].Arg == arg && Hist[i].Paired == paired) return &Hist[i];
+    if (HistCnt == KEYS_MAX) return NULL;
+    memset(&Hist[HistCnt], 0, sizeof(Hist[0]));
+    Hist[HistCnt].Event = ev;
+    Hist[HistCnt].Arg = arg;
+    Hist[HistCnt].Paired = paired;
+    return &Hist[HistCnt++];
+}
+
+/**
+ * @brief Adds one sample to a histogram.
+ */
+static void HistAdd(TraceHist* h, uint64_t ticks)
+{
+    double us = ticks / TicksPerUs;
+    int b = 0;
+    if (!h) return;
+    while (b < HIST_BUCKETS - 1 && us >= (double)(1ULL << b)) b++;
+    h->Bucket[b]++;
+    if (h->Count == 0 || us < h->MinUs) h->MinUs = us;
+    if (us > h->MaxUs) h->MaxUs = us;
+    h->SumUs += us;
+    h->Count++;
+}
+
+/**
+ * @brief Prints the timeline and fills the histograms.
+ */
+static void Timeline(int quiet)
+{
+    struct { uint8_t Event; uint16_t Arg; uint64_t At; } open[OPEN_MAX];
+    int depth = 0, k;
+    size_t i;
+
+    for (i = 0; i < RecCnt; i++)
+    {
+        TraceRec* r = &Recs[i];
+        double durUs = -1;
+
+        r->Abs = i ? Recs[i - 1].Abs + (uint32_t)(r->Ticks - Recs[i - 1].Ticks) : 0;
+        if (r->Event < TRACE_EV_INSTANT && (r->Event & 1) == 0)
+        {
+            if (depth == OPEN_MAX) memmove(open, open + 1, sizeof(open[0]) * --depth);
+            open[depth].Event = r->Event;
+            open[depth].Arg = r->Arg;
+            open[depth++].At = r->Abs;
+        }
+        else if (r->Event < TRACE_EV_INSTANT)
+        {
+            for (k = depth - 1; k >= 0; k--)
+                if (open[k].Event == r->Event - 1) break;
+            if (k >= 0)
+            {
+                HistAdd(HistGet(open[k].Event, open[k].Arg, 1), r->Abs - open[k].At);
+                durUs = (r->Abs - open[k].At) / TicksPerUs;
+                depth = k;
+            }
+        }
+        else
+        {
+            TraceHist* h = HistGet(r->Event, 0, 0);
+            if (h && h->HaveLast) HistAdd(h, r->Abs - h->Last);
+            if (h) { h->HaveLast = 1; h->Last = r->Abs; }
+        }
+        if (quiet) continue;
+        printf("%5u %12.3f  %-15s 0x%04X", r->Seq, r->Abs / TicksPerUs, EventName(r->Event), r->Arg);
+        if (durUs >= 0) printf("  %10.3f us", durUs);
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Prints one line per histogram followed by its non-empty buckets.
+ */
+static void Report(void)
+{
+    size_t i;
+    int b;
+
+    printf("\n%-15s %-6s %-5s %8s %10s %10s %10s   (us)\n", "event", "arg", "kind", "count", "min", "avg", "max");
+    for (i = 0; i < HistCnt; i++)
+    {
+        TraceHist* h = &Hist[i];
+        if (h->Count == 0) continue;
+        printf("%-15s 0x%04X %-5s %8llu %10.3f %10.3f %10.3f\n", EventName(h->Event), h->Arg,
+               h->Paired ? "dur" : "gap", (unsigned long long)h->Count, h->MinUs, h->SumUs / h->Count, h->MaxUs);
+        for (b = 0; b < HIST_BUCKETS; b++)
+        {
+            if (!h->Bucket[b]) continue;
+            printf("    < %8llu us %8llu\n", 1ULL << b, (unsigned long long)h->Bucket[b]);
+        }
+    }
+    if (BadFrames) printf("\n%llu bad frames ignored\n", (unsigned long long)BadFrames);
+}
+
+//==============================================================================
+//-----------------------------------MAIN---------------------------------------
+//==============================================================================
+/**
+ * @brief Receive parser of UartHandleFrame() (UART.c), byte for byte.
+ * @return 1 when the firmware would hand the frame in p->Buf to DealUartData().
+ */
+static int FirmwareFeed(FrameParser* p, uint8_t c)
+{
+    enum { PRE, GETFH1, GETFH2, GETLEN, GETCODE, GETADDR1, GETADDR2 };
+
+    switch (p->State)
+    {
+    case PRE:
+        p->Len = 0;
+        if (c == DTHD1) { p->Buf[p->Len++] = c; p->State = GETFH1; }
+        break;
+    case GETFH1:
+        if (c == DTHD2) { p->Buf[p->Len++] = c; p->State = GETFH2; }
+        else p->State = PRE;
+        break;
+    case GETFH2:
+        if (c < 3 || c > UART_FRAME_MAX) p->State = PRE;
+        else { p->Buf[p->Len++] = c; p->State = GETLEN; }
+        break;
+    case GETLEN:
+        if (c == 0x82 || c == 0x83 || c == TRACE_CMD) { p->Buf[p->Len++] = c; p->State = GETCODE; }
+        else p->State = PRE;
+        break;
+    case GETCODE:
+        p->Buf[p->Len++] = c;
+        p->State = GETADDR1;
+        break;
+    case GETADDR1:
+        p->Buf[p->Len++] = c;
+        p->State = GETADDR2;
+        break;
+    default:
+        p->Buf[p->Len++] = c;
+        if (p->Len == (uint16_t)p->Buf[2] + 3)
+        {
+            p->State = PRE;
+            return 1;
+        }
+        if (p->Len >= sizeof(p->Buf)) p->State = PRE;
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Sends each request form, followed by a VP read, through FirmwareFeed().
+ * @return int 0 if the firmware sees the request with its FLAGS and then the read.
+ */
+static int SelfTest(void)
+{
+    static const uint8_t read83[] = {DTHD1, DTHD2, 0x04, 0x83, 0x10, 0x00, 0x01};
+    uint8_t stream[32];
+    FrameParser p;
+    int crc, frames, failed = 0;
+    size_t len, i;
+
+    for (crc = 0; crc <= 1; crc++)
+    {
+        len = RequestBuild(stream, crc, 1);
+        memcpy(stream + len, read83, sizeof(read83));
+        memset(&p, 0, sizeof(p));
+        for (i = frames = 0; i < len + sizeof(read83); i++)
+        {
+            if (!FirmwareFeed(&p, stream[i])) continue;
+            frames++;
+            if (frames == 1)
+            {
+                int ok = i + 1 == len && p.Buf[3] == TRACE_CMD && (p.Buf[5] & 1)
+                      && p.Buf[2] == TRACE_REQ_LEN + (crc ? 2 : 0);
+                if (ok && crc)
+                {
+                    uint16_t c = Crc16(p.Buf + 3, (uint16_t)(p.Buf[2] - 2));
+                    ok = p.Buf[p.Buf[2] + 1] == (uint8_t)c && p.Buf[p.Buf[2] + 2] == (uint8_t)(c >> 8);
+                }
+                if (!ok) { printf("FAIL %s request not parsed as sent\n", crc ? "CRC" : "plain"); failed = 1; }
+            }
+            else if (frames == 2 && (i + 1 != len + sizeof(read83) || p.Buf[3] != 0x83))
+            {
+                printf("FAIL %s request swallowed the next frame\n", crc ? "CRC" : "plain");
+                failed = 1;
+            }
+        }
+        if (frames != 2) { printf("FAIL %s request: %d frames parsed, want 2\n", crc ? "CRC" : "plain", frames); failed = 1; }
+        else if (!failed) printf("%s request: ok\n", crc ? "CRC" : "plain");
+    }
+    return failed;
+}
+
+/**
+ * @brief Prints command line help.
+ */
+static void Usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s (-d DEVICE | -i FILE | -t) [options]\n"
+        "  -d DEVICE    request the dump over this serial port\n"
+        "  -i FILE      decode a raw dump saved with -o\n"
+        "  -t           self-test the request framing, exit status 0 on success\n"
+        "  -o FILE      save the raw reply (with -d)\n"
+        "  -b BAUD      baud rate (default 115200)\n"
+        "  -c           CRC16 framing (CRC_CHECK_UARTx = 1)\n"
+        "  -C           clear the ring after the dump\n"
+        "  -T MS        reply timeout (default 1000)\n"
+        "  -f FOSC      CPU clock in Hz (default 206438400)\n"
+        "  -q           histograms only, no timeline\n",
+        name);
+    exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    const char* dev = NULL;
+    const char* in = NULL;
+    const char* out = NULL;
+    uint32_t baud = 115200;
+    int opt, clear = 0, quiet = 0, timeoutMs = 1000;
+    FILE* save = NULL;
+
+    while ((opt = getopt(argc, argv, "d:i:o:b:cCT:f:qth")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd': dev = optarg; break;
+        case 'i': in = optarg; break;
+        case 'o': out = optarg; break;
+        case 'b': baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'c': Crc = 1; break;
+        case 'C': clear = 1; break;
+        case 'T': timeoutMs = atoi(optarg); break;
+        case 'f': TicksPerUs = strtod(optarg, NULL) / 12 / 1e6; break;
+        case 'q': quiet = 1; break;
+        case 't': return SelfTest();
+        default: Usage(argv[0]);
+        }
+    }
+    if ((dev == NULL) == (in == NULL) || TicksPerUs <= 0) Usage(argv[0]);
+    if (dev)
+    {
+        if (out && !(save = fopen(out, "wb"))) { perror(out); exit(2); }
+        Fetch(dev, baud, clear, timeoutMs, save);
+        if (save) fclose(save);
+    }
+    else
+    {
+        Load(in);
+    }
+    Timeline(quiet);
+    Report();
+    return (Last && !BadFrames) ? 0 : 3;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
@@ -0,0 +1,314 @@
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file UartHost.c
+ * @brief Host build of the DGUS UART protocol on a PTY.
+ *
+ * Compiles C51/HANDWARE/UART/UART.c with TRACE.c and CRC16.c for the host
+ * and serves UART2 on a pseudo terminal, so TOOLS/DGUS_LOAD and
+ * TOOLS/TRACE_DECODE can be pointed at the real UartHandleFrame(),
+ * Deal82Cmd(), Deal83Cmd() and TraceDump() code instead of a model:
+ *
+ *   ./UartHost [-c] [-A] &           prints the slave path, e.g. /dev/pts/3
+ *   ../DGUS_LOAD/DgusLoad -d /dev/pts/3 -n 10000 -W 8 -v
+ *
+ * Each received byte goes through Uart2TxRxIsr() with RI0 set, exactly as
+ * SBUF0 would deliver it. The main loop then runs UartProcess() like the
+ * UART task and plays the transmitter: while TI0 is set it calls the ISR
+ * and sends whatever lands in SBUF0. InterfaceDelay() runs every host
+ * millisecond, so DELAY_UART2 applies as on the target. VPs are a 64K
+ * word array, big-endian like the DGUS SRAM.
+ *
+ * On the target the TX interrupt drains the ring while UartTxWriteBuffer()
+ * waits on a full one. The host has no interrupt, so the sed step below
+ * gives those two empty wait loops a body, UartSimTxWait(), which shifts
+ * one byte out through the ISR; replies longer than the ring (TraceDump()
+ * sends up to eight 234-byte frames) go out as on the target. A wait with
+ * the transmitter idle could never end and stops the program. Apart from
+ * that and the stripped Keil "interrupt n" suffix the source is unchanged.
+ *
+ * Build (from this directory):
+ *   sed -e 's/) interrupt [0-9]*$/)/' -e 's/^\( *while (.*uart->Tx.*)\);$/\1 UartSimTxWait();/'
+ *      ../../C51/HANDWARE/UART/UART.c > UartFw.c
+ *   cc -O2 -include UartSim.h -I../HOST -I../../C51/HANDWARE/SYSTEM
+ *      -I../../C51/HANDWARE/UART -I../../C51/HANDWARE/TRACE
+ *      -I../../C51/HANDWARE/DIAG -I../../C51/HANDWARE/SCHEDULER
+ *      -I../../C51/HANDWARE/TIMER -o UartHost UartHost.c UartFw.c
+ *      ../../C51/HANDWARE/TRACE/TRACE.c ../../C51/HANDWARE/UART/CRC16.c
+ */
+
+//==============================================================================
+//---------------------------------Includes-------------------------------------
+//==============================================================================
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "SYSTEM.h"
+#include "UART.h"
+#include "TRACE.h"
+#include "DIAG.h"
+#include "SCHEDULER.h"
+
+//==============================================================================
+//---------------------------------Defines--------------------------------------
+//==============================================================================
+#define VP_WORDS        0x10000     ///< Size of the DGUS VP space.
+#define RX_CHUNK        256         ///< Bytes taken from the PTY per pass.
+
+//==============================================================================
+//---------------------------------Variables------------------------------------
+//==============================================================================
+uint8_t EA, TH2, TL2, TF2;                          ///< Core SFRs (UartSim.h).
+uint8_t MUX_SEL, P0MDOUT, ADCON, IEN2;              ///< Pin and interrupt setup.
+uint8_t SCON0, SBUF0, SREL0H, SREL0L, ES0, RI0, TI0;///< UART2.
+uint8_t SCON1, SBUF1, SREL1H, SREL1L;               ///< UART3, unused.
+uint8_t SCON2T, SCON3T;                             ///< UART4/5 TX kick, unused.
+
+uint32_t TimeTicks;                                 ///< TimeStamp.c stand-in.
+uint32_t DiagIsrStart, DiagIsrTicks;                ///< DIAG.c stand-ins.
+uint8_t SchedReady[SCHED_LEVELS];                   ///< SCHEDULER.c stand-ins.
+uint32_t SchedReadyAt[SCHED_TASK_MAX];
+
+extern Uartx_Define Uart2;                          ///< UART.c, not exported by UART.h.
+void Uart2TxRxIsr(void);                            ///< UART.c ISR, "interrupt 4" stripped.
+
+static uint16_t Vp[VP_WORDS];                       ///< DGUS VP space.
+static volatile sig_atomic_t Run = 1;
+static unsigned long RxBytes, TxBytes;
+static int Pty = -1;                                ///< PTY master.
+static uint8_t TxOut[UART_TX_LENGTH];               ///< Bytes shifted out, not yet written.
+static size_t TxLen;
+
+//==============================================================================
+//---------------------------------DGUS-----------------------------------------
+//==============================================================================
+uint16_t ReadDgus(uint16_t Dgus_Addr)
+{
+    return Vp[Dgus_Addr];
+}
+
+void WriteDgus(uint16_t Dgus_Addr, uint16_t Val)
+{
+    Vp[Dgus_Addr] = Val;
+}
+
+void WriteDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
+{
+    while (Len16--)
+    {
+        Vp[Addr++] = (uint16_t)(pBuf[0] << 8) | pBuf[1];
+        pBuf += 2;
+    }
+}
+
+void ReadDgusVp(uint16_t Addr, uint8_t* pBuf, uint16_t Len16)
+{
+    while (Len16--)
+    {
+        *pBuf++ = (uint8_t)(Vp[Addr] >> 8);
+        *pBuf++ = (uint8_t)Vp[Addr++];
+    }
+}
+
+//==============================================================================
+//---------------------------------UART2----------------------------------------
+//==============================================================================
+/**
+ * @brief Monotonic host time in milliseconds.
+ */
+static uint64_t NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Delivers received bytes through the RX ISR.
+ */
+static void UartReceive(const uint8_t* p, size_t n)
+{
+    while (n--)
+    {
+        SBUF0 = *p++;
+        RI0 = 1;
+        Uart2TxRxIsr();
+    }
+}
+
+/**
+ * @brief Writes the bytes shifted out so far to the PTY.
+ */
+static void UartFlush(void)
+{
+    size_t off = 0;
+    ssize_t w;
+
+    while (off < TxLen)
+    {
+        w = write(Pty, TxOut + off, TxLen - off);
+        if (w <= 0) break;
+        off += (size_t)w;
+    }
+    TxBytes += TxLen;
+    TxLen = 0;
+}
+
+/**
+ * @brief One TX interrupt: the ISR loads the next byte into SBUF0, which is then shifted out.
+ * @return int 1 if a byte went out, 0 if the ring was empty and the transmitter went idle.
+ */
+static int UartTxStep(void)
+{
+    uint8_t more = (Uart2.TxRead != Uart2.TxWrite);
+
+    Uart2TxRxIsr();
+    if (!more) return 0;
+    TxOut[TxLen++] = SBUF0;
+    if (TxLen == sizeof(TxOut)) UartFlush();
+    TI0 = 1;                    //Byte shifted out
+    return 1;
+}
+
+/**
+ * @brief Body of the UartTxWriteBuffer() wait loops (sed step): the TX interrupt the target would take.
+ */
+void UartSimTxWait(void)
+{
+    if (!TI0)
+    {
+        fprintf(stderr, "UartTxWriteBuffer() waits on a full TX ring with the transmitter idle\n");
+        exit(3);
+    }
+    UartTxStep();
+}
+
+/**
+ * @brief Runs the TX ISR until the ring is empty and writes the bytes out.
+ */
+static void UartTransmit(void)
+{
+    while (TI0 && UartTxStep());
+    UartFlush();
+}
+
+static void OnSignal(int sig)
+{
+    (void)sig;
+    Run = 0;
+}
+
+static void Usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s [-c] [-A]\n"
+        "  -c    CRC16 framing on UART2 (CRC_CHECK_UART2 = 1)\n"
+        "  -A    writes are not acknowledged (RESPONSE_UART2 = 0)\n",
+        name);
+    exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    struct termios tio;
+    struct pollfd pfd;
+    uint8_t buf[RX_CHUNK];
+    uint64_t ms;
+    int opt, fd, keep, crc = CRC_CHECK_UART2, ack = RESPONSE_UART2;
+    ssize_t n;
+
+    while ((opt = getopt(argc, argv, "cAh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c': crc = 1; break;
+        case 'A': ack = 0; break;
+        default: Usage(argv[0]);
+        }
+    }
+
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) || unlockpt(fd)) { perror("posix_openpt"); return 2; }
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+    //Hold the slave open so the master does not hang up between clients
+    keep = open(ptsname(fd), O_RDWR | O_NOCTTY);
+    Pty = fd;
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    UartInit();
+    TraceInit();
+    Uart2.CrcCheck = (uint8_t)crc;
+    Uart2.Response = (uint8_t)ack;
+    printf("%s\n", ptsname(fd));
+    fflush(stdout);
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    ms = NowMs();
+    while (Run)
+    {
+        if (poll(&pfd, 1, 1) > 0 && (pfd.revents & POLLIN))
+        {
+            n = read(fd, buf, sizeof(buf));
+            if (n > 0)
+            {
+                UartReceive(buf, (size_t)n);
+                RxBytes += (unsigned long)n;
+            }
+        }
+        for (; ms < NowMs(); ms++) InterfaceDelay();
+        while (UartRxPending())
+        {
+            UartProcess();
+            UartTransmit();
+        }
+    }
+
+    fprintf(stderr, "rx %lu bytes, tx %lu bytes\n", RxBytes, TxBytes);
+    close(keep);
+    close(fd);
+    return 0;
+}
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
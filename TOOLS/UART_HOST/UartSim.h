@@ -0,0 +1,63 @@
+#ifndef __UART_SIM_H__
+#define __UART_SIM_H__
+/*
+@verbatim
+--------------------------------------------------------------------------------
+MIT License
+
+Copyright (c) [2025] [Vladimir Radchenko]
+Version 1.0
+
+For communication or thanks, you can contact me by mail DwinRVB@mail.ru
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+--------------------------------------------------------------------------------
+@endverbatim
+*/
+
+/**
+ * @file UartSim.h
+ * @brief Core and UART SFRs as plain variables for building UART/UART.c on the host.
+ *
+ * Force-included (cc -include UartSim.h) ahead of the firmware sources.
+ * UartHost.c defines the variables and plays the UART hardware: it loads
+ * SBUF0 and sets RI0 for each received byte, and sets TI0 again after the
+ * ISR has moved a byte from the TX ring into SBUF0, also from inside the
+ * UartTxWriteBuffer() wait loops (UartSimTxWait()). No system header is
+ * included here, so UartHost.c can still pick its feature macros.
+ */
+
+//==============================================================================
+//--------------------------------Variables-------------------------------------
+//==============================================================================
+extern unsigned char EA, TH2, TL2, TF2;
+extern unsigned char MUX_SEL, P0MDOUT, ADCON, IEN2;
+extern unsigned char SCON0, SBUF0, SREL0H, SREL0L, ES0, RI0, TI0;
+extern unsigned char SCON1, SBUF1, SREL1H, SREL1L;
+extern unsigned char SCON2T, SCON3T;
+
+//==============================================================================
+//--------------------------------FUNCTIONS-------------------------------------
+//==============================================================================
+void UartSimTxWait(void);
+
+//==============================================================================
+//---------------------------------END FILE-------------------------------------
+//==============================================================================
+#endif